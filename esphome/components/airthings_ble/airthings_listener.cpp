@@ -9,15 +9,16 @@ namespace airthings_ble {
 static const char *const TAG = "airthings_ble";
 
 bool AirthingsListener::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
-  for (auto &it : device.get_manufacturer_datas()) {
-    if (it.uuid == esp32_ble_tracker::ESPBTUUID::from_uint32(0x0334)) {
-      if (it.data.size() < 4)
+  for (auto &record : device.get_adv_records()) {
+    auto it = record.as_manufacturer_data();
+    if (it.has_value() && it->uuid == esp32_ble_tracker::ESPBTUUID::from_uint32(0x0334)) {
+      if (it->size < 4)
         continue;
 
-      uint32_t sn = it.data[0];
-      sn |= ((uint32_t) it.data[1] << 8);
-      sn |= ((uint32_t) it.data[2] << 16);
-      sn |= ((uint32_t) it.data[3] << 24);
+      uint32_t sn = it->data[0];
+      sn |= ((uint32_t) it->data[1] << 8);
+      sn |= ((uint32_t) it->data[2] << 16);
+      sn |= ((uint32_t) it->data[3] << 24);
 
       ESP_LOGD(TAG, "Found AirThings device Serial:%u (MAC: %s)", sn, device.address_str().c_str());
       return true;
@@ -20,6 +20,7 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.connection";
+static const uint32_t KEEPALIVE_TIMEOUT_MS = 60000;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
@@ -32,6 +33,7 @@ APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *pa
 #else
 #error "No frame helper defined"
 #endif
+  helper_->set_batch_size(parent->get_batch_size());
 }
 void APIConnection::start() {
   this->last_traffic_ = millis();
@@ -92,10 +94,26 @@ void APIConnection::loop() {
       return;
   }
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  // Send up to batch_size bytes of entities per loop() in a single write, so that the initial burst of states isn't
+  // written one small frame at a time. Without batching this sends a single entity per iterator, like before.
+  bool iterating = !this->list_entities_iterator_.completed() || !this->initial_state_iterator_.completed();
+  this->helper_->begin_batch();
+  while (this->list_entities_iterator_.advance() && this->helper_->batch_has_room()) {
+  }
+  while (this->initial_state_iterator_.advance() && this->helper_->batch_has_room()) {
+  }
+  err = this->helper_->end_batch();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Packet write failed %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+    return;
+  }
+  if (iterating && this->list_entities_iterator_.completed() && this->initial_state_iterator_.completed()) {
+    ESP_LOGD(TAG, "%s: Sent %u packets (%u bytes) in %u writes", client_info_.c_str(),
+             this->helper_->get_packets_sent(), this->helper_->get_packet_bytes(), this->helper_->get_packet_writes());
+  }
 
-  const uint32_t keepalive = 60000;
+  const uint32_t keepalive = KEEPALIVE_TIMEOUT_MS;
   const uint32_t now = millis();
   if (this->sent_ping_) {
     // Disconnect if not responded within 2.5*keepalive
@@ -146,6 +164,21 @@ void APIConnection::loop() {
   }
 }
 
+bool APIConnection::has_pending_loop_work() {
+  if (this->remove_ || this->next_close_ || !network::is_connected() || this->helper_->has_pending_io())
+    return true;
+  if (!this->list_entities_iterator_.completed() || !this->initial_state_iterator_.completed() ||
+      this->state_subs_at_ != -1)
+    return true;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return true;
+#endif
+  // Time to send a ping, or to give up waiting for the response
+  const uint32_t elapsed = millis() - this->last_traffic_;
+  return elapsed > (this->sent_ping_ ? (KEEPALIVE_TIMEOUT_MS * 5) / 2 : KEEPALIVE_TIMEOUT_MS);
+}
+
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
   return App.get_name() + component_type + entity->get_object_id();
 }
@@ -840,7 +873,7 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -17,6 +17,8 @@ class APIConnection : public APIServerConnection {
 
   void start();
   void loop();
+  /// Whether loop() has something to do, for the event-driven application loop.
+  bool has_pending_loop_work();
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -134,6 +136,8 @@ class APIConnection : public APIServerConnection {
   ProtoWriteBuffer create_buffer() override {
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    // leave room for the frame header, so that the frame helper can write the packet without copying the payload
+    this->proto_write_buffer_.resize(this->helper_->frame_header_padding());
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -74,6 +74,50 @@ const char *api_error_to_str(APIError err) {
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
 
+APIError APIFrameHelper::write_packet_raw_(const struct iovec *iov, int iovcnt) {
+  size_t total_len = 0;
+  for (int i = 0; i < iovcnt; i++)
+    total_len += iov[i].iov_len;
+  this->packets_sent_++;
+  this->packet_bytes_ += total_len;
+
+  if (this->batching_) {
+    this->batch_bytes_ += total_len;
+    if (this->batch_buf_.size() + total_len > this->batch_size_) {
+      APIError err = this->flush_batch_();
+      if (err != APIError::OK)
+        return err;
+    }
+    if (total_len <= this->batch_size_) {
+      for (int i = 0; i < iovcnt; i++) {
+        auto *data = reinterpret_cast<uint8_t *>(iov[i].iov_base);
+        this->batch_buf_.insert(this->batch_buf_.end(), data, data + iov[i].iov_len);
+      }
+      return APIError::OK;
+    }
+  }
+
+  this->packet_writes_++;
+  return this->write_raw_(iov, iovcnt);
+}
+APIError APIFrameHelper::flush_batch_() {
+  if (this->batch_buf_.empty())
+    return APIError::OK;
+
+  struct iovec iov;
+  iov.iov_base = this->batch_buf_.data();
+  iov.iov_len = this->batch_buf_.size();
+  this->packet_writes_++;
+  APIError err = this->write_raw_(&iov, 1);
+  // clear() keeps the capacity, so the buffer is only allocated once
+  this->batch_buf_.clear();
+  return err;
+}
+APIError APIFrameHelper::end_batch() {
+  this->batching_ = false;
+  return this->flush_batch_();
+}
+
 #ifdef USE_API_NOISE
 static const char *const PROLOGUE_INIT = "NoiseAPIInit";
 
@@ -458,7 +502,12 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+bool APINoiseFrameHelper::has_pending_io() { return state_ != State::DATA || !tx_buf_.empty() || socket_->ready(); }
+// 3 bytes frame header (indicator + encrypted size), then 4 bytes message type and payload size
+static const uint8_t NOISE_FRAME_HEADER_PADDING = 7;
+
+uint8_t APINoiseFrameHelper::frame_header_padding() { return NOISE_FRAME_HEADER_PADDING; }
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -470,31 +519,27 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  size_t payload_len = raw_buffer->size() - NOISE_FRAME_HEADER_PADDING;
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
   size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
+  // make room for the padding and the MAC, the buffer is reused so this only allocates for a new largest message
+  raw_buffer->resize(frame_len);
+  uint8_t *buf_start = raw_buffer->data();
 
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  buf_start[0] = 0x01;  // indicator
+  // buf_start[1], buf_start[2] to be set later
   const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t)(type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  buf_start[msg_offset + 0] = (uint8_t)(type >> 8);  // type
+  buf_start[msg_offset + 1] = (uint8_t) type;
+  buf_start[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
+  buf_start[msg_offset + 3] = (uint8_t) payload_len;
+  // payload is already in place
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, buf_start + msg_offset, msg_len, frame_len - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -503,15 +548,15 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t)(mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  buf_start[1] = (uint8_t)(mbuf.size >> 8);
+  buf_start[2] = (uint8_t) mbuf.size;
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = buf_start;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
-  return write_raw_(&iov, 1);
+  return write_packet_raw_(&iov, 1);
 }
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -886,23 +931,42 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+bool APIPlaintextFrameHelper::has_pending_io() { return !tx_buf_.empty() || socket_->ready(); }
+// indicator, then payload size (at most 3 varint bytes) and message type (at most 2 varint bytes)
+static const uint8_t PLAINTEXT_FRAME_HEADER_PADDING = 6;
+
+uint8_t APIPlaintextFrameHelper::frame_header_padding() { return PLAINTEXT_FRAME_HEADER_PADDING; }
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  size_t payload_len = raw_buffer->size() - PLAINTEXT_FRAME_HEADER_PADDING;
+
+  // varint lengths vary, so encode the header separately and place it right in front of the payload
+  uint8_t header[PLAINTEXT_FRAME_HEADER_PADDING];
+  uint8_t header_len = 0;
+  header[header_len++] = 0x00;
+  for (uint32_t value : {static_cast<uint32_t>(payload_len), static_cast<uint32_t>(type)}) {
+    do {
+      header[header_len] = value & 0x7F;
+      value >>= 7;
+      if (value)
+        header[header_len] |= 0x80;
+      header_len++;
+    } while (value && header_len < PLAINTEXT_FRAME_HEADER_PADDING);
+    if (value)
+      return APIError::BAD_ARG;
+  }
+  uint8_t *frame_start = raw_buffer->data() + PLAINTEXT_FRAME_HEADER_PADDING - header_len;
+  memcpy(frame_start, header, header_len);
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
+  struct iovec iov;
+  iov.iov_base = frame_start;
+  iov.iov_len = header_len + payload_len;
 
-  return write_raw_(iov, 2);
+  return write_packet_raw_(&iov, 1);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
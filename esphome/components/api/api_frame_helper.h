@@ -12,6 +12,7 @@
 
 #include "esphome/components/socket/socket.h"
 #include "api_noise_context.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
@@ -65,12 +66,54 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /// Whether loop() or read_packet() have something to do: data arrived or buffered data is waiting to be sent.
+  virtual bool has_pending_io() = 0;
+  /// Number of bytes a message buffer has to reserve in front of the payload for the frame header.
+  virtual uint8_t frame_header_padding() = 0;
+  /** Write a packet whose payload was encoded into buffer after frame_header_padding() reserved bytes.
+   *
+   * The frame header (and for encrypted frames, the MAC) are written around the payload in place, so the payload
+   * doesn't have to be copied into another buffer.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
   virtual std::string getpeername() = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+
+  /// Set the maximum number of bytes collected in a batch before it's written to the socket, 0 disables batching.
+  void set_batch_size(size_t batch_size) { batch_size_ = batch_size; }
+  /// Start collecting written packets in a batch, so that they're sent with a single socket write by end_batch().
+  void begin_batch() {
+    batching_ = batch_size_ != 0;
+    batch_bytes_ = 0;
+  }
+  /// Send the packets collected since begin_batch() and stop batching.
+  APIError end_batch();
+  /// Whether fewer than batch_size bytes were written since begin_batch(), including any that were already flushed.
+  bool batch_has_room() const { return batching_ && batch_bytes_ < batch_size_; }
+
+  /// Total number of packets written through write_protobuf_packet().
+  uint32_t get_packets_sent() const { return packets_sent_; }
+  /// Total number of socket writes used to send those packets.
+  uint32_t get_packet_writes() const { return packet_writes_; }
+  /// Total number of bytes sent in those packets.
+  uint32_t get_packet_bytes() const { return packet_bytes_; }
+
+ protected:
+  virtual APIError write_raw_(const struct iovec *iov, int iovcnt) = 0;
+  /// Write a packet, adding it to the current batch instead if batching.
+  APIError write_packet_raw_(const struct iovec *iov, int iovcnt);
+  APIError flush_batch_();
+
+  size_t batch_size_{0};
+  bool batching_{false};
+  size_t batch_bytes_{0};
+  std::vector<uint8_t> batch_buf_;
+  uint32_t packets_sent_{0};
+  uint32_t packet_writes_{0};
+  uint32_t packet_bytes_{0};
 };
 
 #ifdef USE_API_NOISE
@@ -83,7 +126,9 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  bool has_pending_io() override;
+  uint8_t frame_header_padding() override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -99,7 +144,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
   APIError write_frame_(const uint8_t *data, size_t len);
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  APIError write_raw_(const struct iovec *iov, int iovcnt) override;
   APIError init_handshake_();
   APIError check_handshake_finished_();
   void send_explicit_handshake_reject_(const std::string &reason);
@@ -143,7 +188,9 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  bool has_pending_io() override;
+  uint8_t frame_header_padding() override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -157,7 +204,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
 
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  APIError write_raw_(const struct iovec *iov, int iovcnt) override;
 
   std::unique_ptr<socket::Socket> socket_;
 
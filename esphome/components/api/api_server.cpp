@@ -108,6 +108,8 @@ void APIServer::loop() {
   // print disconnection messages
   for (auto it = new_end; it != this->clients_.end(); ++it) {
     ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
+    // The loop doesn't run while connected clients are idle, so the reboot timeout starts from here
+    this->last_connected_ = millis();
   }
   // resize vector
   this->clients_.erase(new_end, this->clients_.end());
@@ -130,6 +132,16 @@ void APIServer::loop() {
     }
   }
 }
+bool APIServer::has_pending_loop_work() {
+  if (this->socket_->ready())
+    return true;
+  for (auto &client : this->clients_) {
+    if (client->has_pending_loop_work())
+      return true;
+  }
+  // Counting down to the reboot needs the loop
+  return this->reboot_timeout_ != 0 && !this->is_connected();
+}
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->port_);
@@ -23,6 +23,7 @@ class APIServer : public Component, public Controller {
   uint16_t get_port() const;
   float get_setup_priority() const override;
   void loop() override;
+  bool has_pending_loop_work() override;
   void dump_config() override;
   void on_shutdown() override;
   bool check_password(const std::string &password) const;
@@ -30,6 +31,9 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Maximum number of bytes of entity states/infos collected in one socket write, 0 disables batching.
+  void set_batch_size(uint16_t batch_size) { this->batch_size_ = batch_size; }
+  uint16_t get_batch_size() const { return this->batch_size_; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -90,6 +94,7 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint16_t batch_size_{1024};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
@@ -143,6 +143,7 @@ class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
   void write(uint8_t value) { this->buffer_->push_back(value); }
+  void write(const uint8_t *data, size_t len) { this->buffer_->insert(this->buffer_->end(), data, data + len); }
   void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
   void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
   void encode_field_raw(uint32_t field_id, uint32_t type) {
@@ -155,9 +156,7 @@ class ProtoWriteBuffer {
 
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
-    auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->write(reinterpret_cast<const uint8_t *>(string), len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
     this->encode_string(field_id, value.data(), value.size());
@@ -188,10 +187,13 @@ class ProtoWriteBuffer {
       return;
 
     this->encode_field_raw(field_id, 5);
-    this->write((value >> 0) & 0xFF);
-    this->write((value >> 8) & 0xFF);
-    this->write((value >> 16) & 0xFF);
-    this->write((value >> 24) & 0xFF);
+    const uint8_t data[4] = {
+        static_cast<uint8_t>((value >> 0) & 0xFF),
+        static_cast<uint8_t>((value >> 8) & 0xFF),
+        static_cast<uint8_t>((value >> 16) & 0xFF),
+        static_cast<uint8_t>((value >> 24) & 0xFF),
+    };
+    this->write(data, 4);
   }
   template<typename T> void encode_enum(uint32_t field_id, T value, bool force = false) {
     this->encode_uint32(field_id, static_cast<uint32_t>(value), force);
@@ -232,11 +234,18 @@ class ProtoWriteBuffer {
 
     value.encode(*this);
 
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
+    uint32_t nested_length = this->buffer_->size() - begin;
+    // add size varint, at most 5 bytes for a 32 bit value
+    uint8_t var[5];
+    size_t var_len = 0;
+    do {
+      var[var_len] = nested_length & 0x7F;
+      nested_length >>= 7;
+      if (nested_length)
+        var[var_len] |= 0x80;
+      var_len++;
+    } while (nested_length);
+    this->buffer_->insert(this->buffer_->begin() + begin, var, var + var_len);
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -18,7 +18,9 @@ class ComponentIterator {
   ComponentIterator(APIServer *server);
 
   void begin();
-  void advance();
+  /// Send the next entity, returns false if nothing was sent (finished, or the send failed).
+  bool advance();
+  bool completed() const { return this->state_ == IteratorState::NONE; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
@@ -10,6 +10,9 @@ static const char *const TAG = "binary_sensor";
 void BinarySensor::add_on_state_callback(std::function<void(bool)> &&callback) {
   this->state_callback_.add(std::move(callback));
 }
+void BinarySensor::add_on_initial_state_callback(std::function<void(bool)> &&callback) {
+  this->initial_state_callback_.add(std::move(callback));
+}
 
 void BinarySensor::publish_state(bool state) {
   if (!this->publish_dedup_.next(state))
@@ -39,6 +42,8 @@ void BinarySensor::send_state_internal(bool state, bool is_initial) {
   this->state = state;
   if (!is_initial) {
     this->state_callback_.call(state);
+  } else {
+    this->initial_state_callback_.call(state);
   }
 }
 std::string BinarySensor::device_class() { return ""; }
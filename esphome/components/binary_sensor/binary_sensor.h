@@ -38,6 +38,12 @@ class BinarySensor : public EntityBase {
    */
   void add_on_state_callback(std::function<void(bool)> &&callback);
 
+  /** Add a callback to be notified of the initial state, which doesn't trigger the state callbacks.
+   *
+   * @param callback The void(bool) callback.
+   */
+  void add_on_initial_state_callback(std::function<void(bool)> &&callback);
+
   /** Publish a new state to the front-end.
    *
    * @param state The new state.
@@ -81,6 +87,7 @@ class BinarySensor : public EntityBase {
   uint32_t hash_base() override;
 
   CallbackManager<void(bool)> state_callback_{};
+  CallbackManager<void(bool)> initial_state_callback_{};
   optional<std::string> device_class_{};  ///< Stores the override of the device class
   Filter *filter_list_{nullptr};
   bool has_state_{false};
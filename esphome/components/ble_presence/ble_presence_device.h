@@ -56,12 +56,10 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
         }
         break;
       case MATCH_BY_SERVICE_UUID:
-        for (auto uuid : device.get_service_uuids()) {
-          if (this->uuid_ == uuid) {
-            this->publish_state(device.get_rssi());
-            this->found_ = true;
-            return true;
-          }
+        if (device.has_service_uuid(this->uuid_)) {
+          this->publish_state(device.get_rssi());
+          this->found_ = true;
+          return true;
         }
         break;
       case MATCH_BY_IBEACON_UUID:
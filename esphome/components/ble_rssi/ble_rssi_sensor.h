@@ -40,12 +40,10 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
         return true;
       }
     } else {
-      for (auto uuid : device.get_service_uuids()) {
-        if (this->uuid_ == uuid) {
-          this->publish_state(device.get_rssi());
-          this->found_ = true;
-          return true;
-        }
+      if (device.has_service_uuid(this->uuid_)) {
+        this->publish_state(device.get_rssi());
+        this->found_ = true;
+        return true;
       }
     }
     return false;
@@ -1,5 +1,6 @@
 #include "debug_component.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/version.h"
@@ -215,7 +216,29 @@ void DebugComponent::dump_config() {
   ESP_LOGD(TAG, "Reset Reason: %s", ESP.getResetReason().c_str());
   ESP_LOGD(TAG, "Reset Info: %s", ESP.getResetInfo().c_str());
 #endif
+
+#ifdef USE_COMPONENT_PROFILING
+  this->dump_profiling_();
+#endif
+}
+#ifdef USE_COMPONENT_PROFILING
+static void dump_profile(const char *source, const char *kind, const ExecutionProfile &profile) {
+  if (profile.get_count() == 0)
+    return;
+  ESP_LOGD(TAG, "  %-24s %-9s calls=%u total=%ums avg=%uus max=%uus p99<=%uus", source, kind, profile.get_count(),
+           static_cast<uint32_t>(profile.get_total_us() / 1000),
+           static_cast<uint32_t>(profile.get_total_us() / profile.get_count()), profile.get_max_us(),
+           profile.get_percentile_us(99.0f));
 }
+void DebugComponent::dump_profiling_() {
+  ESP_LOGD(TAG, "Component Profiling:");
+  for (auto *component : App.get_components()) {
+    dump_profile(component->get_component_source(), "loop", component->get_loop_profile());
+    dump_profile(component->get_component_source(), "scheduler", component->get_scheduler_profile());
+  }
+  dump_profile("<application>", "jitter", App.get_loop_jitter_profile());
+}
+#endif
 void DebugComponent::loop() {
 #ifdef USE_ARDUINO
   uint32_t new_free_heap = ESP.getFreeHeap();  // NOLINT(readability-static-accessed-through-instance)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 
 namespace esphome {
 namespace debug {
@@ -12,6 +13,10 @@ class DebugComponent : public Component {
   void dump_config() override;
 
  protected:
+#ifdef USE_COMPONENT_PROFILING
+  void dump_profiling_();
+#endif
+
   uint32_t free_heap_{};
 };
 
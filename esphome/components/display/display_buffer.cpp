@@ -1,5 +1,6 @@
 #include "display_buffer.h"
 
+#include <algorithm>
 #include <utility>
 #include "esphome/core/application.h"
 #include "esphome/core/color.h"
@@ -23,6 +24,46 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
     return;
   }
   this->clear();
+  // the contents of the display's memory are unknown, so the first flush has to write everything
+  this->mark_dirty_all_();
+}
+bool DisplayBuffer::take_dirty_region_(int *x1, int *y1, int *x2, int *y2) {
+  *x1 = std::max(this->dirty_x1_, 0);
+  *y1 = std::max(this->dirty_y1_, 0);
+  *x2 = std::min(this->dirty_x2_, this->get_width_internal() - 1);
+  *y2 = std::min(this->dirty_y2_, this->get_height_internal() - 1);
+  this->clear_dirty_region_();
+  return *x1 <= *x2 && *y1 <= *y2;
+}
+static uint32_t hash_line(const uint8_t *data, size_t length) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+bool DisplayBuffer::skip_unchanged_lines_(int *first, int *last, size_t line_bytes) {
+  // lines that were never flushed have a hash of 0 and are thus (almost) always considered changed
+  if (this->line_hashes_.size() <= size_t(*last))
+    this->line_hashes_.resize(*last + 1, 0);
+
+  int changed_first = -1, changed_last = -1;
+  for (int line = *first; line <= *last; line++) {
+    uint32_t hash = hash_line(this->buffer_ + line * line_bytes, line_bytes);
+    if (hash == this->line_hashes_[line])
+      continue;
+    this->line_hashes_[line] = hash;
+    if (changed_first == -1)
+      changed_first = line;
+    changed_last = line;
+  }
+  if (changed_first == -1)
+    return false;
+  *first = changed_first;
+  *last = changed_last;
+  return true;
 }
 void DisplayBuffer::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void DisplayBuffer::clear() { this->fill(COLOR_OFF); }
@@ -90,14 +131,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->filled_rectangle(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->filled_rectangle(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -105,10 +142,83 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1, y1, height, color);
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
-void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+void HOT DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  if (width <= 0 || height <= 0)
+    return;
+
+  // rotate the rectangle once, instead of every pixel
+  int x, y, w, h;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+    default:
+      x = x1;
+      y = y1;
+      w = width;
+      h = height;
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      x = this->get_width_internal() - y1 - height;
+      y = x1;
+      w = height;
+      h = width;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = this->get_width_internal() - x1 - width;
+      y = this->get_height_internal() - y1 - height;
+      w = width;
+      h = height;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      x = y1;
+      y = this->get_height_internal() - x1 - width;
+      w = height;
+      h = width;
+      break;
+  }
+
+  this->fill_absolute_rect_internal(x, y, w, h, color);
+  App.feed_wdt();
+}
+bool DisplayBuffer::clip_absolute_rect_(int *x, int *y, int *width, int *height) {
+  if (*x < 0) {
+    *width += *x;
+    *x = 0;
+  }
+  if (*y < 0) {
+    *height += *y;
+    *y = 0;
+  }
+  *width = std::min(*width, this->get_width_internal() - *x);
+  *height = std::min(*height, this->get_height_internal() - *y);
+  return *width > 0 && *height > 0;
+}
+void DisplayBuffer::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  for (int j = y; j < y + height; j++) {
+    for (int i = x; i < x + width; i++)
+      this->draw_absolute_pixel_internal(i, j, color);
+  }
+}
+void HOT DisplayBuffer::draw_bitmap_(int x, int y, const uint8_t *data, int width, int height, Color color_on,
+                                     optional<Color> color_off) {
+  // rows are padded to full bytes, most significant bit first
+  const uint32_t stride = (width + 7u) / 8u;
+  for (int row = 0; row < height; row++) {
+    const uint8_t *row_data = data + row * stride;
+    int run_start = 0;
+    bool run_on = progmem_read_byte(row_data) & 0x80;
+    // draw the runs of set (and unset) pixels as lines
+    for (int col = 1; col <= width; col++) {
+      bool on = col < width && (progmem_read_byte(row_data + col / 8u) & (0x80 >> (col % 8u)));
+      if (col < width && on == run_on)
+        continue;
+      if (run_on) {
+        this->horizontal_line(x + run_start, y + row, col - run_start, color_on);
+      } else if (color_off.has_value()) {
+        this->horizontal_line(x + run_start, y + row, col - run_start, *color_off);
+      }
+      run_start = col;
+      run_on = on;
+    }
   }
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
@@ -176,9 +286,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].glyph_data_->width;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        this->filled_rectangle(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -189,14 +297,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     const Glyph &glyph = font->get_glyphs()[glyph_n];
     int scan_x1, scan_y1, scan_width, scan_height;
     glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    this->draw_bitmap_(scan_x1 + x_at, scan_y1 + y_start, glyph.glyph_data_->data, scan_width, scan_height, color, {});
 
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
@@ -211,28 +312,38 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 }
 
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
-  switch (image->get_type()) {
-    case IMAGE_TYPE_BINARY:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? color_on : color_off);
-        }
-      }
-      break;
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_grayscale_pixel(img_x, img_y));
-        }
-      }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_color_pixel(img_x, img_y));
-        }
-      }
-      break;
+  if (image->get_type() == IMAGE_TYPE_BINARY) {
+    const uint8_t *data = image->get_binary_data();
+    if (data != nullptr) {
+      this->draw_bitmap_(x, y, data, image->get_width(), image->get_height(), color_on, color_off);
+      return;
+    }
+  }
+
+  auto get_color = [image, color_on, color_off](int img_x, int img_y) {
+    switch (image->get_type()) {
+      case IMAGE_TYPE_BINARY:
+        return image->get_pixel(img_x, img_y) ? color_on : color_off;
+      case IMAGE_TYPE_GRAYSCALE:
+        return image->get_grayscale_pixel(img_x, img_y);
+      case IMAGE_TYPE_RGB24:
+      default:
+        return image->get_color_pixel(img_x, img_y);
+    }
+  };
+  const int width = image->get_width();
+  for (int img_y = 0; img_y < image->get_height(); img_y++) {
+    // draw runs of the same color as lines
+    int run_start = 0;
+    Color run_color = get_color(0, img_y);
+    for (int img_x = 1; img_x <= width; img_x++) {
+      Color color = img_x < width ? get_color(img_x, img_y) : run_color;
+      if (img_x < width && color.raw_32 == run_color.raw_32)
+        continue;
+      this->horizontal_line(x + run_start, y + img_y, img_x - run_start, run_color);
+      run_start = img_x;
+      run_color = color;
+    }
   }
 }
 
@@ -487,6 +598,7 @@ Color Image::get_grayscale_pixel(int x, int y) const {
   const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
   return Color(gray | gray << 8 | gray << 16 | gray << 24);
 }
+const uint8_t *Image::get_binary_data() const { return this->data_start_; }
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
@@ -503,6 +615,13 @@ bool Animation::get_pixel(int x, int y) const {
   const uint32_t pos = x + y * width_8 + frame_index;
   return progmem_read_byte(this->data_start_ + (pos / 8u)) & (0x80 >> (pos % 8u));
 }
+const uint8_t *Animation::get_binary_data() const {
+  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
+  const uint32_t frame_index = this->height_ * width_8 * this->current_frame_;
+  if (frame_index >= (uint32_t)(this->width_ * this->height_ * this->animation_frame_count_))
+    return nullptr;
+  return this->data_start_ + frame_index / 8u;
+}
 Color Animation::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
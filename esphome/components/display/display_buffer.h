@@ -341,6 +341,20 @@ class DisplayBuffer {
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Fill a rectangle of the display (in unrotated coordinates) with color.
+   *
+   * The rectangle isn't clipped, like the pixels passed to draw_absolute_pixel_internal(). The default implementation
+   * draws each pixel with draw_absolute_pixel_internal(), drivers can override this to write whole rows of their
+   * buffer at once.
+   */
+  virtual void fill_absolute_rect_internal(int x, int y, int width, int height, Color color);
+  /// Clip a rectangle in unrotated coordinates to the display, returns false if nothing is left.
+  bool clip_absolute_rect_(int *x, int *y, int *width, int *height);
+
+  /// Draw a packed 1-bit bitmap (rows padded to full bytes) as runs of color_on and (optionally) color_off.
+  void draw_bitmap_(int x, int y, const uint8_t *data, int width, int height, Color color_on,
+                    optional<Color> color_off);
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
@@ -349,6 +363,49 @@ class DisplayBuffer {
 
   void do_update_();
 
+  /// Add the pixel at [x,y] (in unrotated display coordinates) to the region that changed since the last flush.
+  void mark_dirty_(int x, int y) {
+    if (x < this->dirty_x1_)
+      this->dirty_x1_ = x;
+    if (x > this->dirty_x2_)
+      this->dirty_x2_ = x;
+    if (y < this->dirty_y1_)
+      this->dirty_y1_ = y;
+    if (y > this->dirty_y2_)
+      this->dirty_y2_ = y;
+  }
+  /// Mark the whole display as changed, e.g. when the display's memory contents are unknown.
+  void mark_dirty_all_() {
+    this->mark_dirty_(0, 0);
+    this->mark_dirty_(this->get_width_internal() - 1, this->get_height_internal() - 1);
+  }
+  /// Forget the changed region, e.g. after the buffer has been sent to the display by other means.
+  void clear_dirty_region_() {
+    this->dirty_x1_ = this->dirty_y1_ = INT16_MAX;
+    this->dirty_x2_ = this->dirty_y2_ = -1;
+  }
+  /** Get the bounding box of the pixels that changed since the last call, and clear it.
+   *
+   * Drivers that can write a window of the display memory call this when flushing their buffer, so that only the
+   * changed part is transmitted.
+   *
+   * @return false if no pixel changed, in which case nothing has to be transmitted.
+   */
+  bool take_dirty_region_(int *x1, int *y1, int *x2, int *y2);
+  /** Shrink the range of lines [first,last] to skip the lines at its start and end whose contents didn't change.
+   *
+   * With auto clear, every frame clears and redraws the same pixels, which marks them dirty even if they end up with
+   * the same value. To detect this, a hash of each line of the buffer is kept and compared when flushing.
+   *
+   * @param first The first line to flush, is updated to the first changed line.
+   * @param last The last line to flush, is updated to the last changed line.
+   * @param line_bytes The number of bytes of the buffer used by a line.
+   * @return false if none of the lines changed.
+   */
+  bool skip_unchanged_lines_(int *first, int *last, size_t line_bytes);
+  /// Forget the line hashes, to be called when the display memory was written without going through the buffer.
+  void reset_line_hashes_() { this->line_hashes_.clear(); }
+
   uint8_t *buffer_{nullptr};
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
   optional<display_writer_t> writer_{};
@@ -356,6 +413,11 @@ class DisplayBuffer {
   DisplayPage *previous_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
   bool auto_clear_enabled_{true};
+  int dirty_x1_{INT16_MAX};
+  int dirty_y1_{INT16_MAX};
+  int dirty_x2_{-1};
+  int dirty_y2_{-1};
+  std::vector<uint32_t> line_hashes_;
 };
 
 class DisplayPage {
@@ -434,6 +496,8 @@ class Image {
   virtual bool get_pixel(int x, int y) const;
   virtual Color get_color_pixel(int x, int y) const;
   virtual Color get_grayscale_pixel(int x, int y) const;
+  /// Get the packed pixel data of the current frame of a binary image, or nullptr if not available.
+  virtual const uint8_t *get_binary_data() const;
   int get_width() const;
   int get_height() const;
   ImageType get_type() const;
@@ -451,6 +515,7 @@ class Animation : public Image {
   bool get_pixel(int x, int y) const override;
   Color get_color_pixel(int x, int y) const override;
   Color get_grayscale_pixel(int x, int y) const override;
+  const uint8_t *get_binary_data() const override;
 
   int get_animation_frame_count() const;
   int get_current_frame() const;
@@ -42,9 +42,7 @@ bool Dsmr::ready_to_request_data_() {
       this->start_requesting_data_();
     }
     if (!this->requesting_data_) {
-      while (this->available()) {
-        this->read();
-      }
+      this->drain_rx_();
     }
   }
   return this->requesting_data_;
@@ -59,10 +57,24 @@ bool Dsmr::request_interval_reached_() {
 
 bool Dsmr::receive_timeout_reached_() { return millis() - this->last_read_time_ > this->receive_timeout_; }
 
+bool Dsmr::read_chunk_() {
+  this->chunk_pos_ = 0;
+  this->chunk_len_ = this->read_available(this->chunk_, sizeof(this->chunk_));
+  return this->chunk_len_ != 0;
+}
+
+void Dsmr::drain_rx_() {
+  while (this->read_chunk_()) {
+  }
+}
+
 bool Dsmr::available_within_timeout_() {
+  // Bytes left over from the last chunk?
+  if (this->chunk_pos_ < this->chunk_len_)
+    return true;
   // Data are available for reading on the UART bus?
   // Then we can start reading right away.
-  if (this->available()) {
+  if (this->read_chunk_()) {
     this->last_read_time_ = millis();
     return true;
   }
@@ -80,7 +92,7 @@ bool Dsmr::available_within_timeout_() {
   if (this->parent_->get_rx_buffer_size() < this->max_telegram_len_) {
     while (!this->receive_timeout_reached_()) {
       delay(5);
-      if (this->available()) {
+      if (this->read_chunk_()) {
         this->last_read_time_ = millis();
         return true;
       }
@@ -117,9 +129,7 @@ void Dsmr::stop_requesting_data_() {
     } else {
       ESP_LOGV(TAG, "Stop reading data from P1 port");
     }
-    while (this->available()) {
-      this->read();
-    }
+    this->drain_rx_();
     this->requesting_data_ = false;
   }
 }
@@ -135,7 +145,7 @@ void Dsmr::reset_telegram_() {
 
 void Dsmr::receive_telegram_() {
   while (this->available_within_timeout_()) {
-    const char c = this->read();
+    const char c = this->chunk_[this->chunk_pos_++];
 
     // Find a new telegram header, i.e. forward slash.
     if (c == '/') {
@@ -189,7 +199,7 @@ void Dsmr::receive_telegram_() {
 
 void Dsmr::receive_encrypted_telegram_() {
   while (this->available_within_timeout_()) {
-    const char c = this->read();
+    const char c = this->chunk_[this->chunk_pos_++];
 
     // Find a new telegram start byte.
     if (!this->header_found_) {
@@ -98,6 +98,10 @@ class Dsmr : public Component, public uart::UARTDevice {
   /// time that the UART RX buffer overflows and bytes of the telegram get
   /// lost in the process.
   bool available_within_timeout_();
+  /// Read the next chunk of received data into chunk_, returns false if nothing was received.
+  bool read_chunk_();
+  /// Discard all data that has been received.
+  void drain_rx_();
 
   // Request telegram
   uint32_t request_interval_;
@@ -119,6 +123,10 @@ class Dsmr : public Component, public uart::UARTDevice {
   size_t crypt_telegram_len_{0};
   size_t crypt_bytes_read_{0};
   uint32_t last_read_time_{0};
+  /// UART data is read in chunks and then handled byte by byte from here.
+  uint8_t chunk_[64];
+  uint8_t chunk_pos_{0};
+  uint8_t chunk_len_{0};
   bool header_found_{false};
   bool footer_found_{false};
 
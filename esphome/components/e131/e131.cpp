@@ -18,6 +18,11 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+static const int DDP_PORT = 4048;
+// Largest E1.31 packet with 512 channels
+static const size_t E131_MAX_PACKET_SIZE = 638;
+// DDP header with timecode followed by the 480 RGB LEDs senders put in one packet at most
+static const size_t DDP_MAX_PACKET_SIZE = 14 + 1440;
 
 E131Component::E131Component() {}
 
@@ -25,6 +30,9 @@ E131Component::~E131Component() {
   if (udp_) {
     udp_->stop();
   }
+  if (ddp_udp_) {
+    ddp_udp_->stop();
+  }
 }
 
 void E131Component::setup() {
@@ -36,32 +44,140 @@ void E131Component::setup() {
     return;
   }
 
+  this->buffer_size_ = E131_MAX_PACKET_SIZE;
+  if (this->ddp_) {
+    this->ddp_udp_ = make_unique<WiFiUDP>();
+    if (!this->ddp_udp_->begin(DDP_PORT)) {
+      ESP_LOGE(TAG, "Cannot bind DDP to %d.", DDP_PORT);
+      mark_failed();
+      return;
+    }
+    this->buffer_size_ = DDP_MAX_PACKET_SIZE;
+  }
+  this->buffer_ = make_unique<uint8_t[]>(this->buffer_size_);
+
   join_igmp_groups_();
+
+  this->set_interval("stats", 60000, [this]() { this->log_stats_(); });
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
+  this->receive_e131_();
+  if (this->ddp_udp_)
+    this->receive_ddp_();
+}
+
+void E131Component::receive_e131_() {
   E131Packet packet;
   int universe = 0;
 
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    const uint32_t start = micros();
+    if (packet_size > this->buffer_size_) {
+      ESP_LOGV(TAG, "Ignored E1.31 packet of size %u.", packet_size);
+      continue;
+    }
+
+    if (udp_->read(this->buffer_.get(), packet_size) != packet_size) {
+      continue;
+    }
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (!packet_(this->buffer_.get(), packet_size, universe, packet)) {
+      ESP_LOGV(TAG, "Invalid packet received of size %u.", packet_size);
       continue;
     }
 
-    if (!packet_(payload, universe, packet)) {
-      ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
+    E131UniverseStats *universe_stats = this->find_universe_(universe);
+    if (universe_stats == nullptr) {
+      ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+      continue;
+    }
+
+    auto &stats = *universe_stats;
+    const int8_t diff = packet.sequence - stats.last_sequence;
+    if (stats.received && diff <= 0 && diff > -20) {
+      // Out of order or duplicate packet, E1.31 says to discard these
+      stats.dropped++;
       continue;
     }
+    if (stats.received && diff > 1)
+      stats.dropped += diff - 1;
+    stats.received = true;
+    stats.last_sequence = packet.sequence;
+    stats.packets++;
 
     if (!process_(universe, packet)) {
       ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
     }
+    stats.max_latency = std::max(stats.max_latency, micros() - start);
   }
 }
 
+void E131Component::receive_ddp_() {
+  DDPPacket packet;
+
+  while (uint16_t packet_size = this->ddp_udp_->parsePacket()) {
+    const uint32_t start = micros();
+    if (packet_size > this->buffer_size_) {
+      ESP_LOGV(TAG, "Ignored DDP packet of size %u.", packet_size);
+      continue;
+    }
+
+    if (this->ddp_udp_->read(this->buffer_.get(), packet_size) != packet_size) {
+      continue;
+    }
+
+    if (!this->ddp_packet_(this->buffer_.get(), packet_size, packet)) {
+      ESP_LOGV(TAG, "Invalid DDP packet received of size %u.", packet_size);
+      continue;
+    }
+
+    auto &stats = this->ddp_stats_;
+    if (packet.sequence != 0) {
+      // Sequence numbers count from 1 to 15, steps of more than half of that are taken as going backwards
+      if (stats.received && stats.last_sequence != 0) {
+        const uint8_t step = (packet.sequence - stats.last_sequence + 15) % 15;
+        if (step == 0 || step > 7) {
+          // Out of order or duplicate packet, discarded like E1.31 ones
+          stats.dropped++;
+          continue;
+        }
+        stats.dropped += step - 1;
+      }
+      stats.last_sequence = packet.sequence;
+    }
+    stats.received = true;
+    stats.packets++;
+
+    if (!this->process_ddp_(packet)) {
+      ESP_LOGV(TAG, "Ignored DDP packet for offset %u of size %u.", packet.offset, packet.length);
+    }
+    stats.max_latency = std::max(stats.max_latency, micros() - start);
+  }
+}
+
+void E131Component::log_stats_() {
+  for (auto &it : this->universes_) {
+    auto &stats = it.stats;
+    if (!stats.received)
+      continue;
+    ESP_LOGD(TAG, "Universe %u: %u packets, %u dropped, max latency %u us", it.universe, stats.packets, stats.dropped,
+             stats.max_latency);
+    stats.max_latency = 0;
+  }
+  if (this->ddp_stats_.received) {
+    ESP_LOGD(TAG, "DDP: %u packets, %u dropped, max latency %u us", this->ddp_stats_.packets, this->ddp_stats_.dropped,
+             this->ddp_stats_.max_latency);
+    this->ddp_stats_.max_latency = 0;
+  }
+}
+
+void E131Component::dump_config() {
+  ESP_LOGCONFIG(TAG, "E1.31:");
+  ESP_LOGCONFIG(TAG, "  Method: %s", this->listen_method_ == E131_MULTICAST ? "Multicast" : "Unicast");
+  ESP_LOGCONFIG(TAG, "  DDP: %s", YESNO(this->ddp_));
+}
+
 void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
   if (light_effects_.count(light_effect)) {
     return;
@@ -104,6 +220,18 @@ bool E131Component::process_(int universe, const E131Packet &packet) {
   return handled;
 }
 
+bool E131Component::process_ddp_(const DDPPacket &packet) {
+  bool handled = false;
+
+  ESP_LOGV(TAG, "Received DDP packet for offset %u, with %u bytes", packet.offset, packet.length);
+
+  for (auto *light_effect : light_effects_) {
+    handled = light_effect->process_ddp_(packet) || handled;
+  }
+
+  return handled;
+}
+
 }  // namespace e131
 }  // namespace esphome
 
@@ -6,7 +6,7 @@
 
 #include <memory>
 #include <set>
-#include <map>
+#include <vector>
 
 class UDP;
 
@@ -19,9 +19,34 @@ enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
 
+/// Channel data of a received E1.31 packet, pointing into the receive buffer.
 struct E131Packet {
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  uint8_t sequence;
+  const uint8_t *values;
+};
+
+/// Channel data of a received DDP packet, pointing into the receive buffer.
+struct DDPPacket {
+  uint8_t sequence;  ///< 1-15, 0 if the sender doesn't number its packets.
+  uint32_t offset;   ///< Offset in bytes of the first channel in the data.
+  uint16_t length;
+  const uint8_t *data;
+};
+
+/// Reception statistics of a single universe, or of the DDP stream.
+struct E131UniverseStats {
+  uint16_t consumers{0};
+  uint8_t last_sequence{0};
+  bool received{false};
+  uint32_t packets{0};
+  uint32_t dropped{0};
+  uint32_t max_latency{0};  ///< Longest time in us from reading a packet until its data was in the LED buffer.
+};
+
+struct E131Universe {
+  uint16_t universe;
+  E131UniverseStats stats;
 };
 
 class E131Component : public esphome::Component {
@@ -31,6 +56,7 @@ class E131Component : public esphome::Component {
 
   void setup() override;
   void loop() override;
+  void dump_config() override;
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
  public:
@@ -39,20 +65,35 @@ class E131Component : public esphome::Component {
 
  public:
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
+  /// Also listen for DDP packets, which can carry up to 480 RGB LEDs each.
+  void set_ddp(bool ddp) { this->ddp_ = ddp; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  bool packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet);
+  bool ddp_packet_(const uint8_t *data, size_t size, DDPPacket &packet);
   bool process_(int universe, const E131Packet &packet);
+  bool process_ddp_(const DDPPacket &packet);
+  void receive_e131_();
+  void receive_ddp_();
+  void log_stats_();
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
+  /// Find a joined universe, nullptr if it isn't joined.
+  E131UniverseStats *find_universe_(int universe);
 
  protected:
   E131ListenMethod listen_method_{E131_MULTICAST};
+  bool ddp_{false};
   std::unique_ptr<UDP> udp_;
+  std::unique_ptr<UDP> ddp_udp_;
+  /// Datagrams are read into this buffer and parsed in place.
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t buffer_size_{0};
   std::set<E131AddressableLightEffect *> light_effects_;
-  std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  /// Joined universes, sorted by universe number.
+  std::vector<E131Universe> universes_;
+  E131UniverseStats ddp_stats_;
 };
 
 }  // namespace e131
@@ -8,7 +8,7 @@ namespace esphome {
 namespace e131 {
 
 static const char *const TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = E131_MAX_PROPERTY_VALUES_COUNT - 1;
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -55,41 +55,78 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
 
   int output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
-  int output_end =
-      std::min(it->size(), std::min(output_offset + get_lights_per_universe(), output_offset + packet.count - 1));
+  int output_end = std::min(it->size(), std::min(output_offset + get_lights_per_universe(),
+                                                  output_offset + (packet.count - 1) / channels_));
   auto input_data = packet.values + 1;
 
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
-  switch (channels_) {
-    case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
-      break;
+  this->write_lights_(output_offset, input_data, output_end - output_offset);
 
-    case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
-      break;
+  it->schedule_show();
+  return true;
+}
 
-    case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
-      break;
+bool E131AddressableLightEffect::process_ddp_(const DDPPacket &packet) {
+  auto *it = get_addressable_();
+
+  // DDP addresses all channels as a single stream, this light starts at the channel where its first universe would
+  // start if the stream was split into universes like E1.31 does, so the same sender layout works for both.
+  const uint32_t first_channel = (first_universe_ - 1) * get_data_per_universe();
+  const uint32_t end_channel = first_channel + it->size() * channels_;
+  uint32_t offset = packet.offset;
+  const uint8_t *data = packet.data;
+  uint32_t end = packet.offset + packet.length;
+  if (end <= first_channel || offset >= end_channel)
+    return false;
+
+  // Skip data of lights before this one and a partial LED at the start
+  if (offset < first_channel) {
+    data += first_channel - offset;
+    offset = first_channel;
   }
+  const uint32_t partial = (channels_ - (offset - first_channel) % channels_) % channels_;
+  data += partial;
+  offset += partial;
+  end = std::min(end, end_channel);
+  if (offset >= end)
+    return false;
 
+  this->write_lights_((offset - first_channel) / channels_, data, (end - offset) / channels_);
   it->schedule_show();
   return true;
 }
 
+void E131AddressableLightEffect::write_lights_(int32_t first, const uint8_t *data, int32_t count) {
+  auto *it = get_addressable_();
+
+  // Convert in chunks on the stack and write them in bulk instead of going through an ESPColorView per LED
+  Color colors[light::EFFECT_CHUNK_SIZE];
+  while (count > 0) {
+    const int32_t chunk = std::min(count, light::EFFECT_CHUNK_SIZE);
+    for (int32_t i = 0; i < chunk; i++) {
+      switch (channels_) {
+        case E131_MONO:
+          colors[i] = Color(data[0], data[0], data[0], data[0]);
+          data += 1;
+          break;
+        case E131_RGB:
+          colors[i] = Color(data[0], data[1], data[2], (data[0] + data[1] + data[2]) / 3);
+          data += 3;
+          break;
+        case E131_RGBW:
+          colors[i] = Color(data[0], data[1], data[2], data[3]);
+          data += 4;
+          break;
+      }
+    }
+    it->write(first, colors, chunk);
+    first += chunk;
+    count -= chunk;
+  }
+}
+
 }  // namespace e131
 }  // namespace esphome
 
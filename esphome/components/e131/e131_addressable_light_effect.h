@@ -10,6 +10,7 @@ namespace e131 {
 
 class E131Component;
 struct E131Packet;
+struct DDPPacket;
 
 enum E131LightChannels { E131_MONO = 1, E131_RGB = 3, E131_RGBW = 4 };
 
@@ -36,6 +37,9 @@ class E131AddressableLightEffect : public light::AddressableLightEffect {
 
  protected:
   bool process_(int universe, const E131Packet &packet);
+  bool process_ddp_(const DDPPacket &packet);
+  /// Write count LEDs starting at first from the channel data in data.
+  void write_lights_(int32_t first, const uint8_t *data, int32_t count);
 
  protected:
   int first_universe_{0};
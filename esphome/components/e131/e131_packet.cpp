@@ -1,9 +1,11 @@
 #ifdef USE_ARDUINO
 
 #include "e131.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 #include "esphome/components/network/ip_address.h"
+#include <algorithm>
 #include <cstring>
 
 #include <lwip/init.h>
@@ -21,6 +23,17 @@ static const uint32_t VECTOR_ROOT = 4;
 static const uint32_t VECTOR_FRAME = 2;
 static const uint8_t VECTOR_DMP = 2;
 
+// DDP header flags
+static const uint8_t DDP_FLAGS_VERSION_MASK = 0xC0;
+static const uint8_t DDP_FLAGS_VERSION_1 = 0x40;
+static const uint8_t DDP_FLAGS_TIMECODE = 0x10;
+static const uint8_t DDP_FLAGS_QUERY = 0x02;
+static const uint8_t DDP_FLAGS_REPLY = 0x04;
+// Destination ID of the default output device
+static const uint8_t DDP_ID_DISPLAY = 1;
+static const size_t DDP_HEADER_SIZE = 10;
+static const size_t DDP_TIMECODE_SIZE = 4;
+
 // E1.31 Packet Structure
 union E131RawPacket {
   struct {
@@ -65,26 +78,38 @@ bool E131Component::join_igmp_groups_() {
   if (!udp_)
     return false;
 
-  for (auto universe : universe_consumers_) {
-    if (!universe.second)
-      continue;
-
-    ip4_addr_t multicast_addr = {static_cast<uint32_t>(
-        network::IPAddress(239, 255, ((universe.first >> 8) & 0xff), ((universe.first >> 0) & 0xff)))};
+  for (auto &it : this->universes_) {
+    const uint16_t universe = it.universe;
+    ip4_addr_t multicast_addr = {
+        static_cast<uint32_t>(network::IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)))};
 
     auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
 
     if (err) {
-      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.first);
+      ESP_LOGW(TAG, "IGMP join for %u universe of E1.31 failed. Multicast might not work.", universe);
     }
   }
 
   return true;
 }
 
+static std::vector<E131Universe>::iterator universe_lower_bound(std::vector<E131Universe> &universes, int universe) {
+  return std::lower_bound(universes.begin(), universes.end(), universe,
+                          [](const E131Universe &a, int b) { return a.universe < b; });
+}
+
+E131UniverseStats *E131Component::find_universe_(int universe) {
+  auto it = universe_lower_bound(this->universes_, universe);
+  if (it == this->universes_.end() || it->universe != universe)
+    return nullptr;
+  return &it->stats;
+}
+
 void E131Component::join_(int universe) {
-  // store only latest received packet for the given universe
-  auto consumers = ++universe_consumers_[universe];
+  auto it = universe_lower_bound(this->universes_, universe);
+  if (it == this->universes_.end() || it->universe != universe)
+    it = this->universes_.insert(it, E131Universe{static_cast<uint16_t>(universe), {}});
+  auto consumers = ++it->stats.consumers;
 
   if (consumers > 1) {
     return;  // we already joined before
@@ -96,11 +121,14 @@ void E131Component::join_(int universe) {
 }
 
 void E131Component::leave_(int universe) {
-  auto consumers = --universe_consumers_[universe];
+  auto it = universe_lower_bound(this->universes_, universe);
+  if (it == this->universes_.end() || it->universe != universe)
+    return;
 
-  if (consumers > 0) {
+  if (--it->stats.consumers > 0) {
     return;  // we have other consumers of the given universe
   }
+  this->universes_.erase(it);
 
   if (listen_method_ == E131_MULTICAST) {
     ip4_addr_t multicast_addr = {
@@ -112,11 +140,11 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
+bool E131Component::packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet) {
+  if (size < E131_MIN_PACKET_SIZE)
     return false;
 
-  auto sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  auto sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
     return false;
@@ -133,8 +161,40 @@ bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E13
   packet.count = htons(sbuff->property_value_count);
   if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
     return false;
+  // The channel data is used straight from the receive buffer, so it has to be all there
+  if (size < E131_MIN_PACKET_SIZE - 1 + packet.count)
+    return false;
+
+  packet.sequence = sbuff->sequence_number;
+  packet.values = sbuff->property_values;
+  return true;
+}
+
+bool E131Component::ddp_packet_(const uint8_t *data, size_t size, DDPPacket &packet) {
+  // See http://www.3waylabs.com/ddp/
+  if (size < DDP_HEADER_SIZE)
+    return false;
+
+  const uint8_t flags = data[0];
+  if ((flags & DDP_FLAGS_VERSION_MASK) != DDP_FLAGS_VERSION_1)
+    return false;
+  // Nothing to answer status or config queries with
+  if (flags & (DDP_FLAGS_QUERY | DDP_FLAGS_REPLY))
+    return false;
+  if (data[3] != DDP_ID_DISPLAY)
+    return false;
+
+  size_t header_size = DDP_HEADER_SIZE;
+  if (flags & DDP_FLAGS_TIMECODE)
+    header_size += DDP_TIMECODE_SIZE;
+
+  packet.sequence = data[1] & 0x0F;
+  packet.offset = encode_uint32(data[4], data[5], data[6], data[7]);
+  packet.length = encode_uint16(data[8], data[9]);
+  if (size < header_size + packet.length)
+    return false;
 
-  memcpy(packet.values, sbuff->property_values, packet.count);
+  packet.data = data + header_size;
   return true;
 }
 
@@ -35,7 +35,12 @@ void arch_restart() {
   }
 }
 
+// Task that runs the main loop, to which wakeup notifications are sent.
+static TaskHandle_t wakeup_task_handle = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 void arch_init() {
+  wakeup_task_handle = xTaskGetCurrentTaskHandle();
+
   // Enable the task watchdog only on the loop task (from which we're currently running)
 #if defined(USE_ESP_IDF)
   esp_task_wdt_add(nullptr);
@@ -52,6 +57,21 @@ void arch_init() {
 #endif
 }
 void IRAM_ATTR HOT arch_feed_wdt() { esp_task_wdt_reset(); }
+bool IRAM_ATTR HOT arch_wait_for_wakeup(uint32_t ms) {
+  return ulTaskNotifyTake(pdTRUE, ms / portTICK_PERIOD_MS) != 0;
+}
+void arch_wake_loop() {
+  if (wakeup_task_handle != nullptr)
+    xTaskNotifyGive(wakeup_task_handle);
+}
+void IRAM_ATTR arch_wake_loop_isr() {
+  if (wakeup_task_handle == nullptr)
+    return;
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  vTaskNotifyGiveFromISR(wakeup_task_handle, &higher_priority_task_woken);
+  if (higher_priority_task_woken)
+    portYIELD_FROM_ISR();
+}
 
 uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
 uint32_t arch_get_cpu_cycle_count() {
@@ -13,42 +13,37 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
-struct NVSData {
-  std::string key;
-  std::vector<uint8_t> data;
-};
+class ESP32PreferenceBackend;
 
-static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Preferences with data waiting to be written to NVS on the next sync.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<ESP32PreferenceBackend *> s_pending_save;
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
   std::string key;
   uint32_t nvs_handle;
+  /// Data waiting to be written by the next sync, the buffer is kept around so that later saves can reuse it.
+  std::vector<uint8_t> pending_data;
+  bool pending{false};
+
   bool save(const uint8_t *data, size_t len) override {
-    // try find in pending saves and update that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        obj.data.assign(data, data + len);
-        return true;
-      }
+    this->pending_data.assign(data, data + len);
+    if (!this->pending) {
+      this->pending = true;
+      s_pending_save.push_back(this);
     }
-    NVSData save{};
-    save.key = key;
-    save.data.assign(data, data + len);
-    s_pending_save.emplace_back(save);
     return true;
   }
   bool load(uint8_t *data, size_t len) override {
-    // try find in pending saves and load from that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        if (obj.data.size() != len) {
-          // size mismatch
-          return false;
-        }
-        memcpy(data, obj.data.data(), len);
-        return true;
+    // load pending data that hasn't been written yet
+    if (this->pending) {
+      if (this->pending_data.size() != len) {
+        // size mismatch
+        return false;
       }
+      memcpy(data, this->pending_data.data(), len);
+      return true;
     }
 
     size_t actual_len;
@@ -117,14 +112,15 @@ class ESP32Preferences : public ESPPreferences {
 
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
-      esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
+      auto *save = s_pending_save[i];
+      esp_err_t err = nvs_set_blob(nvs_handle, save->key.c_str(), save->pending_data.data(), save->pending_data.size());
       if (err != 0) {
-        ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
+        ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save->key.c_str(), save->pending_data.size(),
                  esp_err_to_name(err));
         any_failed = true;
         continue;
       }
+      save->pending = false;
       s_pending_save.erase(s_pending_save.begin() + i);
     }
 
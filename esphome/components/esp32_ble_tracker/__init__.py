@@ -23,6 +23,8 @@ CONF_ESP32_BLE_ID = "esp32_ble_id"
 CONF_SCAN_PARAMETERS = "scan_parameters"
 CONF_WINDOW = "window"
 CONF_ACTIVE = "active"
+CONF_EVENT_QUEUE_SIZE = "event_queue_size"
+CONF_DEDUP_INTERVAL = "dedup_interval"
 esp32_ble_tracker_ns = cg.esphome_ns.namespace("esp32_ble_tracker")
 ESP32BLETracker = esp32_ble_tracker_ns.class_("ESP32BLETracker", cg.Component)
 ESPBTClient = esp32_ble_tracker_ns.class_("ESPBTClient")
@@ -142,6 +144,10 @@ CONFIG_SCHEMA = cv.Schema(
             ),
             validate_scan_parameters,
         ),
+        cv.Optional(CONF_EVENT_QUEUE_SIZE, default=64): cv.int_range(min=8, max=1024),
+        cv.Optional(
+            CONF_DEDUP_INTERVAL, default="0s"
+        ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_ON_BLE_ADVERTISE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ESPBTAdvertiseTrigger),
@@ -186,6 +192,8 @@ async def to_code(config):
     cg.add(var.set_scan_interval(int(params[CONF_INTERVAL].total_milliseconds / 0.625)))
     cg.add(var.set_scan_window(int(params[CONF_WINDOW].total_milliseconds / 0.625)))
     cg.add(var.set_scan_active(params[CONF_ACTIVE]))
+    cg.add(var.set_event_queue_size(config[CONF_EVENT_QUEUE_SIZE]))
+    cg.add(var.set_dedup_interval(config[CONF_DEDUP_INTERVAL]))
     for conf in config.get(CONF_ON_BLE_ADVERTISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         if CONF_MAC_ADDRESS in conf:
@@ -222,7 +230,11 @@ async def to_code(config):
 
 async def register_ble_device(var, config):
     paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
-    cg.add(paren.register_listener(var))
+    if CONF_MAC_ADDRESS in config:
+        # The listener only cares about this device, so don't offer it any others
+        cg.add(paren.register_listener(var, config[CONF_MAC_ADDRESS].as_hex))
+    else:
+        cg.add(paren.register_listener(var))
     return var
 
 
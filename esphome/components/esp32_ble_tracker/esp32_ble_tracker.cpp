@@ -14,6 +14,8 @@
 #include <freertos/task.h>
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
+#include <algorithm>
+#include <new>
 
 #ifdef USE_ARDUINO
 #include <esp32-hal-bt.h>
@@ -44,6 +46,7 @@ float ESP32BLETracker::get_setup_priority() const { return setup_priority::BLUET
 
 void ESP32BLETracker::setup() {
   global_esp32_ble_tracker = this;
+  this->ble_events_.init(this->event_queue_size_);
   this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
 
@@ -56,15 +59,25 @@ void ESP32BLETracker::setup() {
 }
 
 void ESP32BLETracker::loop() {
-  BLEEvent *ble_event = this->ble_events_.pop();
+  BLEEvent *ble_event = this->ble_events_.front();
   while (ble_event != nullptr) {
     if (ble_event->type_)
       this->real_gattc_event_handler_(ble_event->event_.gattc.gattc_event, ble_event->event_.gattc.gattc_if,
                                       &ble_event->event_.gattc.gattc_param);
     else
       this->real_gap_event_handler_(ble_event->event_.gap.gap_event, &ble_event->event_.gap.gap_param);
-    delete ble_event;  // NOLINT(cppcoreguidelines-owning-memory)
-    ble_event = this->ble_events_.pop();
+    this->ble_events_.pop();
+    // Hand over full batches of scan results right away, so none of the queued ones have to be dropped
+    if (this->scan_result_index_ >= 16)
+      this->process_scan_results_();
+    ble_event = this->ble_events_.front();
+  }
+
+  const uint32_t dropped = this->ble_events_.get_dropped();
+  if (dropped != this->reported_dropped_events_) {
+    ESP_LOGW(TAG, "BLE event queue full, dropped %u events (%u total). Consider increasing event_queue_size.",
+             dropped - this->reported_dropped_events_, dropped);
+    this->reported_dropped_events_ = dropped;
   }
 
   bool connecting = false;
@@ -77,43 +90,7 @@ void ESP32BLETracker::loop() {
     global_esp32_ble_tracker->start_scan_(false);
   }
 
-  if (xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-    uint32_t index = this->scan_result_index_;
-    xSemaphoreGive(this->scan_result_lock_);
-
-    if (index >= 16) {
-      ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
-    }
-    for (size_t i = 0; i < index; i++) {
-      ESPBTDevice device;
-      device.parse_scan_rst(this->scan_result_buffer_[i]);
-
-      bool found = false;
-      for (auto *listener : this->listeners_)
-        if (listener->parse_device(device))
-          found = true;
-
-      for (auto *client : this->clients_)
-        if (client->parse_device(device)) {
-          found = true;
-          if (client->state() == ClientState::DISCOVERED) {
-            esp_ble_gap_stop_scanning();
-            if (xSemaphoreTake(this->scan_end_lock_, 10L / portTICK_PERIOD_MS)) {
-              xSemaphoreGive(this->scan_end_lock_);
-            }
-          }
-        }
-
-      if (!found) {
-        this->print_bt_device_info(device);
-      }
-    }
-
-    if (xSemaphoreTake(this->scan_result_lock_, 10L / portTICK_PERIOD_MS)) {
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
-    }
-  }
+  this->process_scan_results_();
 
   if (this->scan_set_param_failed_) {
     ESP_LOGE(TAG, "Scan set param failed: %d", this->scan_set_param_failed_);
@@ -126,6 +103,12 @@ void ESP32BLETracker::loop() {
   }
 }
 
+bool ESP32BLETracker::has_pending_loop_work() {
+  // Events are queued by the Bluetooth task, which wakes up the loop. A finished scan is restarted from loop().
+  return this->ble_events_.front() != nullptr || this->scan_result_index_ != 0 ||
+         uxSemaphoreGetCount(this->scan_end_lock_) != 0 || this->scan_set_param_failed_ || this->scan_start_failed_;
+}
+
 bool ESP32BLETracker::ble_setup() {
   // Initialize non-volatile storage for the bluetooth controller
   esp_err_t err = nvs_flash_init();
@@ -215,6 +198,8 @@ void ESP32BLETracker::start_scan_(bool first) {
   if (!first) {
     for (auto *listener : this->listeners_)
       listener->on_scan_end();
+    for (auto &entry : this->address_listeners_)
+      entry.second->on_scan_end();
   }
   this->already_discovered_.clear();
   this->scan_params_.scan_type = this->scan_active_ ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
@@ -232,15 +217,28 @@ void ESP32BLETracker::start_scan_(bool first) {
   });
 }
 
+void ESP32BLETracker::register_listener(ESPBTDeviceListener *listener, uint64_t address) {
+  listener->set_parent(this);
+  auto it = std::upper_bound(this->address_listeners_.begin(), this->address_listeners_.end(), address,
+                             [](uint64_t address, const std::pair<uint64_t, ESPBTDeviceListener *> &entry) {
+                               return address < entry.first;
+                             });
+  this->address_listeners_.insert(it, {address, listener});
+}
+
 void ESP32BLETracker::register_client(ESPBTClient *client) {
   client->app_id = ++this->app_id_;
   this->clients_.push_back(client);
 }
 
 void ESP32BLETracker::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
-  BLEEvent *gap_event = new BLEEvent(event, param);  // NOLINT(cppcoreguidelines-owning-memory)
-  global_esp32_ble_tracker->ble_events_.push(gap_event);
-}  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+  BLEEvent *gap_event = global_esp32_ble_tracker->ble_events_.reserve();
+  if (gap_event == nullptr)
+    return;  // counted by the queue, reported in loop()
+  new (gap_event) BLEEvent(event, param);
+  global_esp32_ble_tracker->ble_events_.commit();
+  App.wake_loop();
+}
 
 void ESP32BLETracker::real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
   switch (event) {
@@ -261,6 +259,76 @@ void ESP32BLETracker::real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_
   }
 }
 
+void ESP32BLETracker::process_scan_results_() {
+  if (xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
+    uint32_t index = this->scan_result_index_;
+    xSemaphoreGive(this->scan_result_lock_);
+
+    for (size_t i = 0; i < index; i++) {
+      if (this->is_duplicate_(this->scan_result_buffer_[i]))
+        continue;
+
+      ESPBTDevice device;
+      device.parse_scan_rst(this->scan_result_buffer_[i]);
+
+      bool found = false;
+      for (auto *listener : this->listeners_)
+        if (listener->parse_device(device))
+          found = true;
+
+      const uint64_t address = device.address_uint64();
+      auto it = std::lower_bound(this->address_listeners_.begin(), this->address_listeners_.end(), address,
+                                 [](const std::pair<uint64_t, ESPBTDeviceListener *> &entry, uint64_t address) {
+                                   return entry.first < address;
+                                 });
+      for (; it != this->address_listeners_.end() && it->first == address; it++)
+        if (it->second->parse_device(device))
+          found = true;
+
+      for (auto *client : this->clients_)
+        if (client->parse_device(device)) {
+          found = true;
+          if (client->state() == ClientState::DISCOVERED) {
+            esp_ble_gap_stop_scanning();
+            if (xSemaphoreTake(this->scan_end_lock_, 10L / portTICK_PERIOD_MS)) {
+              xSemaphoreGive(this->scan_end_lock_);
+            }
+          }
+        }
+
+      if (!found) {
+        this->print_bt_device_info(device);
+      }
+    }
+
+    if (xSemaphoreTake(this->scan_result_lock_, 10L / portTICK_PERIOD_MS)) {
+      this->scan_result_index_ = 0;
+      xSemaphoreGive(this->scan_result_lock_);
+    }
+  }
+}
+
+bool ESP32BLETracker::is_duplicate_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+  if (this->dedup_interval_ == 0)
+    return false;
+
+  const uint64_t address = ble_addr_to_uint64(param.bda);
+  // FNV-1a over the advertisement and scan response data
+  uint32_t hash = 2166136261UL;
+  const size_t len = std::min<size_t>(param.adv_data_len + param.scan_rsp_len, sizeof(param.ble_adv));
+  for (size_t i = 0; i < len; i++)
+    hash = (hash ^ param.ble_adv[i]) * 16777619UL;
+
+  const uint32_t now = millis();
+  auto &entry = this->dedup_cache_[(address ^ (address >> 16) ^ (address >> 32)) % this->dedup_cache_.size()];
+  if (entry.address == address && entry.hash == hash && now - entry.time < this->dedup_interval_)
+    return true;
+  entry.address = address;
+  entry.hash = hash;
+  entry.time = now;
+  return false;
+}
+
 void ESP32BLETracker::gap_scan_set_param_complete_(const esp_ble_gap_cb_param_t::ble_scan_param_cmpl_evt_param &param) {
   this->scan_set_param_failed_ = param.status;
 }
@@ -288,9 +356,13 @@ void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_re
 
 void ESP32BLETracker::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                           esp_ble_gattc_cb_param_t *param) {
-  BLEEvent *gattc_event = new BLEEvent(event, gattc_if, param);  // NOLINT(cppcoreguidelines-owning-memory)
-  global_esp32_ble_tracker->ble_events_.push(gattc_event);
-}  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+  BLEEvent *gattc_event = global_esp32_ble_tracker->ble_events_.reserve();
+  if (gattc_event == nullptr)
+    return;  // counted by the queue, reported in loop()
+  new (gattc_event) BLEEvent(event, gattc_if, param);
+  global_esp32_ble_tracker->ble_events_.commit();
+  App.wake_loop();
+}
 
 void ESP32BLETracker::real_gattc_event_handler_(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                                 esp_ble_gattc_cb_param_t *param) {
@@ -481,6 +553,14 @@ optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceData
     return {};
   return ESPBLEiBeacon(data.data.data());
 }
+optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceDataView &data) {
+  if (!data.uuid.contains(0x4C, 0x00))
+    return {};
+
+  if (data.size != 23)
+    return {};
+  return ESPBLEiBeacon(data.data);
+}
 
 void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   this->scan_result_ = param;
@@ -488,7 +568,7 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
+  this->adv_parsed_ = false;
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
   ESP_LOGVV(TAG, "Parse Result:");
@@ -510,6 +590,7 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "  Address: %02X:%02X:%02X:%02X:%02X:%02X (%s)", this->address_[0], this->address_[1],
             this->address_[2], this->address_[3], this->address_[4], this->address_[5], address_type);
 
+  this->parse_adv_();
   ESP_LOGVV(TAG, "  RSSI: %d", this->rssi_);
   ESP_LOGVV(TAG, "  Name: '%s'", this->name_.c_str());
   for (auto &it : this->tx_powers_) {
@@ -544,21 +625,134 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "Adv data: %s", format_hex_pretty(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
+optional<ServiceDataView> ESPBTAdvRecord::as_manufacturer_data() const {
+  // CSS 1.4 MANUFACTURER SPECIFIC DATA
+  // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
+  // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
+  // shall be defined by the manufacturer specified by the company identifier."
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  if (this->type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE)
+    return {};
+  if (this->length < 2) {
+    ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
+    return {};
+  }
+  return ServiceDataView{ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0])), this->data + 2,
+                         static_cast<uint8_t>(this->length - 2)};
+}
+optional<ServiceDataView> ESPBTAdvRecord::as_service_data() const {
+  // CSS 1.11 SERVICE DATA
+  // "The Service Data data type consists of a service UUID with the data associated with that service."
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_SERVICE_DATA: {
+      // «Service Data - 16 bit UUID»
+      // Size: 2 or more octets
+      // The first 2 octets contain the 16 bit Service UUID fol- lowed by additional service data
+      if (this->length < 2) {
+        ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
+        return {};
+      }
+      return ServiceDataView{ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0])), this->data + 2,
+                             static_cast<uint8_t>(this->length - 2)};
+    }
+    case ESP_BLE_AD_TYPE_32SERVICE_DATA: {
+      // «Service Data - 32 bit UUID»
+      // Size: 4 or more octets
+      // The first 4 octets contain the 32 bit Service UUID fol- lowed by additional service data
+      if (this->length < 4) {
+        ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
+        return {};
+      }
+      return ServiceDataView{
+          ESPBTUUID::from_uint32(encode_uint32(this->data[3], this->data[2], this->data[1], this->data[0])),
+          this->data + 4, static_cast<uint8_t>(this->length - 4)};
+    }
+    case ESP_BLE_AD_TYPE_128SERVICE_DATA: {
+      // «Service Data - 128 bit UUID»
+      // Size: 16 or more octets
+      // The first 16 octets contain the 128 bit Service UUID followed by additional service data
+      if (this->length < 16) {
+        ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
+        return {};
+      }
+      return ServiceDataView{ESPBTUUID::from_raw(this->data), this->data + 16, static_cast<uint8_t>(this->length - 16)};
+    }
+    default:
+      return {};
+  }
+}
+bool ESPBTAdvRecord::has_service_uuid(const ESPBTUUID &uuid) const {
+  // CSS 1.1 SERVICE UUID
+  // The Service UUID data type is used to include a list of Service or Service Class UUIDs.
+  // There are six data types defined for the three sizes of Service UUIDs that may be returned:
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_16SRV_CMPL:
+    case ESP_BLE_AD_TYPE_16SRV_PART:
+      // • 16-bit Bluetooth Service UUIDs
+      for (uint8_t i = 0; i + 2 <= this->length; i += 2) {
+        if (ESPBTUUID::from_uint16(encode_uint16(this->data[i + 1], this->data[i])) == uuid)
+          return true;
+      }
+      return false;
+    case ESP_BLE_AD_TYPE_32SRV_CMPL:
+    case ESP_BLE_AD_TYPE_32SRV_PART:
+      // • 32-bit Bluetooth Service UUIDs
+      for (uint8_t i = 0; i + 4 <= this->length; i += 4) {
+        if (ESPBTUUID::from_uint32(encode_uint32(this->data[i + 3], this->data[i + 2], this->data[i + 1],
+                                                 this->data[i])) == uuid)
+          return true;
+      }
+      return false;
+    case ESP_BLE_AD_TYPE_128SRV_CMPL:
+    case ESP_BLE_AD_TYPE_128SRV_PART:
+      // • Global 128-bit Service UUIDs
+      return this->length >= 16 && ESPBTUUID::from_raw(this->data) == uuid;
+    default:
+      return false;
+  }
+}
 
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0)
-      break;
+bool ESPBTDevice::has_service_uuid(const ESPBTUUID &uuid) const {
+  for (auto &record : this->get_adv_records()) {
+    if (record.has_service_uuid(uuid))
+      return true;
+  }
+  return false;
+}
+optional<ServiceDataView> ESPBTDevice::find_manufacturer_data(const ESPBTUUID &uuid) const {
+  for (auto &record : this->get_adv_records()) {
+    auto data = record.as_manufacturer_data();
+    if (data.has_value() && data->uuid == uuid)
+      return data;
+  }
+  return {};
+}
+optional<ServiceDataView> ESPBTDevice::find_service_data(const ESPBTUUID &uuid) const {
+  for (auto &record : this->get_adv_records()) {
+    auto data = record.as_service_data();
+    if (data.has_value() && data->uuid == uuid)
+      return data;
+  }
+  return {};
+}
 
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
+void ESPBTDevice::parse_adv_() const {
+  if (this->adv_parsed_)
+    return;
+  this->adv_parsed_ = true;
+  this->name_.clear();
+  this->tx_powers_.clear();
+  this->appearance_.reset();
+  this->ad_flag_.reset();
+  this->service_uuids_.clear();
+  this->manufacturer_datas_.clear();
+  this->service_datas_.clear();
+
+  for (auto &record : this->get_adv_records()) {
+    const uint8_t *data = record.data;
+    const uint8_t length = record.length;
 
     // See also Generic Access Profile Assigned Numbers:
     // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
@@ -566,19 +760,19 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
     // See also Core Specification Supplement: https://www.bluetooth.com/specifications/bluetooth-core-specification/
     // (called CSS here)
 
-    switch (record_type) {
+    switch (record.type) {
       case ESP_BLE_AD_TYPE_NAME_CMPL: {
         // CSS 1.2 LOCAL NAME
         // "The Local Name data type shall be the same as, or a shortened version of, the local name assigned to the
         // device." CSS 1: Optional in this context; shall not appear more than once in a block.
-        this->name_ = std::string(reinterpret_cast<const char *>(record), record_length);
+        this->name_ = std::string(reinterpret_cast<const char *>(data), length);
         break;
       }
       case ESP_BLE_AD_TYPE_TX_PWR: {
         // CSS 1.5 TX POWER LEVEL
         // "The TX Power Level data type indicates the transmitted power level of the packet containing the data type."
         // CSS 1: Optional in this context (may appear more than once in a block).
-        this->tx_powers_.push_back(*payload);
+        this->tx_powers_.push_back(static_cast<int8_t>(*data));
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
@@ -587,7 +781,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // See also https://www.bluetooth.com/specifications/gatt/characteristics/
         // CSS 1: Optional in this context; shall not appear more than once in a block and shall not appear in both
         // the AD and SRD of the same extended advertising interval.
-        this->appearance_ = *reinterpret_cast<const uint16_t *>(record);
+        if (length >= 2)
+          this->appearance_ = encode_uint16(data[1], data[0]);
         break;
       }
       case ESP_BLE_AD_TYPE_FLAG: {
@@ -596,99 +791,45 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // Flag bits are non-zero and the advertising packet is connectable, otherwise the Flags data type may be
         // omitted."
         // CSS 1: Optional in this context; shall not appear more than once in a block.
-        this->ad_flag_ = *record;
+        this->ad_flag_ = *data;
         break;
       }
-      // CSS 1.1 SERVICE UUID
-      // The Service UUID data type is used to include a list of Service or Service Class UUIDs.
-      // There are six data types defined for the three sizes of Service UUIDs that may be returned:
-      // CSS 1: Optional in this context (may appear more than once in a block).
       case ESP_BLE_AD_TYPE_16SRV_CMPL:
       case ESP_BLE_AD_TYPE_16SRV_PART: {
-        // • 16-bit Bluetooth Service UUIDs
-        for (uint8_t i = 0; i < record_length / 2; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record + 2 * i)));
-        }
+        for (uint8_t i = 0; i + 2 <= length; i += 2)
+          this->service_uuids_.push_back(ESPBTUUID::from_uint16(encode_uint16(data[i + 1], data[i])));
         break;
       }
       case ESP_BLE_AD_TYPE_32SRV_CMPL:
       case ESP_BLE_AD_TYPE_32SRV_PART: {
-        // • 32-bit Bluetooth Service UUIDs
-        for (uint8_t i = 0; i < record_length / 4; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record + 4 * i)));
+        for (uint8_t i = 0; i + 4 <= length; i += 4) {
+          this->service_uuids_.push_back(
+              ESPBTUUID::from_uint32(encode_uint32(data[i + 3], data[i + 2], data[i + 1], data[i])));
         }
         break;
       }
       case ESP_BLE_AD_TYPE_128SRV_CMPL:
       case ESP_BLE_AD_TYPE_128SRV_PART: {
-        // • Global 128-bit Service UUIDs
-        this->service_uuids_.push_back(ESPBTUUID::from_raw(record));
+        if (length >= 16)
+          this->service_uuids_.push_back(ESPBTUUID::from_raw(data));
         break;
       }
       case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
-        // CSS 1.4 MANUFACTURER SPECIFIC DATA
-        // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
-        // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
-        // shall be defined by the manufacturer specified by the company identifier."
-        // CSS 1: Optional in this context (may appear more than once in a block).
-        if (record_length < 2) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->manufacturer_datas_.push_back(data);
-        break;
-      }
-
-      // CSS 1.11 SERVICE DATA
-      // "The Service Data data type consists of a service UUID with the data associated with that service."
-      // CSS 1: Optional in this context (may appear more than once in a block).
-      case ESP_BLE_AD_TYPE_SERVICE_DATA: {
-        // «Service Data - 16 bit UUID»
-        // Size: 2 or more octets
-        // The first 2 octets contain the 16 bit Service UUID fol- lowed by additional service data
-        if (record_length < 2) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->service_datas_.push_back(data);
-        break;
-      }
-      case ESP_BLE_AD_TYPE_32SERVICE_DATA: {
-        // «Service Data - 32 bit UUID»
-        // Size: 4 or more octets
-        // The first 4 octets contain the 32 bit Service UUID fol- lowed by additional service data
-        if (record_length < 4) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record));
-        data.data.assign(record + 4UL, record + record_length);
-        this->service_datas_.push_back(data);
+        auto view = record.as_manufacturer_data();
+        if (view.has_value())
+          this->manufacturer_datas_.push_back(ServiceData{view->uuid, view->to_vector()});
         break;
       }
+      case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      case ESP_BLE_AD_TYPE_32SERVICE_DATA:
       case ESP_BLE_AD_TYPE_128SERVICE_DATA: {
-        // «Service Data - 128 bit UUID»
-        // Size: 16 or more octets
-        // The first 16 octets contain the 128 bit Service UUID followed by additional service data
-        if (record_length < 16) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_raw(record);
-        data.data.assign(record + 16UL, record + record_length);
-        this->service_datas_.push_back(data);
+        auto view = record.as_service_data();
+        if (view.has_value())
+          this->service_datas_.push_back(ServiceData{view->uuid, view->to_vector()});
         break;
       }
       default: {
-        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record_type);
+        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record.type);
         break;
       }
     }
@@ -8,9 +8,12 @@
 
 #include <string>
 #include <array>
+#include <algorithm>
 #include <esp_gap_ble_api.h>
 #include <esp_gattc_api.h>
 #include <esp_bt_defs.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 namespace esphome {
 namespace esp32_ble_tracker {
@@ -51,11 +54,83 @@ struct ServiceData {
   adv_data_t data;
 };
 
+/// Manufacturer or service data pointing into the raw advertisement, only valid as long as the device it came from.
+struct ServiceDataView {
+  ESPBTUUID uuid;
+  const uint8_t *data;
+  uint8_t size;
+
+  adv_data_t to_vector() const { return adv_data_t(this->data, this->data + this->size); }
+};
+
+/// A single AD structure of an advertisement, pointing into the raw advertisement data.
+struct ESPBTAdvRecord {
+  uint8_t type;
+  const uint8_t *data;
+  uint8_t length;
+
+  /// The company identifier and payload if this is a manufacturer specific data record.
+  optional<ServiceDataView> as_manufacturer_data() const;
+  /// The service UUID and payload if this is a 16, 32 or 128 bit service data record.
+  optional<ServiceDataView> as_service_data() const;
+  /// Whether this is a service UUID list that contains uuid.
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+};
+
+/// Walks the AD structures of an advertisement without copying anything.
+class ESPBTAdvRecordIterator {
+ public:
+  ESPBTAdvRecordIterator(const uint8_t *payload, uint8_t len, uint8_t offset)
+      : payload_(payload), len_(len), offset_(offset) {
+    this->load_();
+  }
+
+  const ESPBTAdvRecord &operator*() const { return this->record_; }
+  const ESPBTAdvRecord *operator->() const { return &this->record_; }
+  ESPBTAdvRecordIterator &operator++() {
+    this->offset_ += this->record_.length + 2;
+    this->load_();
+    return *this;
+  }
+  bool operator==(const ESPBTAdvRecordIterator &other) const { return this->offset_ == other.offset_; }
+  bool operator!=(const ESPBTAdvRecordIterator &other) const { return this->offset_ != other.offset_; }
+
+ protected:
+  void load_() {
+    // Every record needs at least its length, type and one byte of data
+    if (this->offset_ + 2 >= this->len_ || this->payload_[this->offset_] == 0) {
+      this->offset_ = this->len_;
+      return;
+    }
+    this->record_.type = this->payload_[this->offset_ + 1];
+    this->record_.data = &this->payload_[this->offset_ + 2];
+    // Don't trust the record length to stay within the advertisement
+    this->record_.length = std::min<uint8_t>(this->payload_[this->offset_] - 1, this->len_ - this->offset_ - 2);
+  }
+
+  const uint8_t *payload_;
+  uint8_t len_;
+  uint8_t offset_;
+  ESPBTAdvRecord record_{};
+};
+
+class ESPBTAdvRecords {
+ public:
+  ESPBTAdvRecords(const uint8_t *payload, uint8_t len) : payload_(payload), len_(len) {}
+  ESPBTAdvRecordIterator begin() const { return {this->payload_, this->len_, 0}; }
+  ESPBTAdvRecordIterator end() const { return {this->payload_, this->len_, this->len_}; }
+
+ protected:
+  const uint8_t *payload_;
+  uint8_t len_;
+};
+
 class ESPBLEiBeacon {
  public:
   ESPBLEiBeacon() { memset(&this->beacon_data_, 0, sizeof(this->beacon_data_)); }
   ESPBLEiBeacon(const uint8_t *data);
   static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceData &data);
+  static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceDataView &data);
 
   uint16_t get_major() { return ((this->beacon_data_.major & 0xFF) << 8) | (this->beacon_data_.major >> 8); }
   uint16_t get_minor() { return ((this->beacon_data_.minor & 0xFF) << 8) | (this->beacon_data_.minor >> 8); }
@@ -85,23 +160,55 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
-
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
-
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
-
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  /// The AD structures of the advertisement and scan response, iterating these doesn't allocate anything.
+  ESPBTAdvRecords get_adv_records() const {
+    return {this->scan_result_.ble_adv,
+            static_cast<uint8_t>(std::min<size_t>(this->scan_result_.adv_data_len + this->scan_result_.scan_rsp_len,
+                                                  sizeof(this->scan_result_.ble_adv)))};
+  }
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+  optional<ServiceDataView> find_manufacturer_data(const ESPBTUUID &uuid) const;
+  optional<ServiceDataView> find_service_data(const ESPBTUUID &uuid) const;
+
+  // These copy the advertisement into owned containers the first time any of them is called.
+  const std::string &get_name() const {
+    this->parse_adv_();
+    return this->name_;
+  }
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->parse_adv_();
+    return this->tx_powers_;
+  }
+  const optional<uint16_t> &get_appearance() const {
+    this->parse_adv_();
+    return this->appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->parse_adv_();
+    return this->ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->parse_adv_();
+    return this->service_uuids_;
+  }
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->parse_adv_();
+    return this->manufacturer_datas_;
+  }
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->parse_adv_();
+    return this->service_datas_;
+  }
 
   const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return scan_result_; }
 
   optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
-      auto res = ESPBLEiBeacon::from_manufacturer_data(it);
+    for (auto &record : this->get_adv_records()) {
+      auto data = record.as_manufacturer_data();
+      if (!data.has_value())
+        continue;
+      auto res = ESPBLEiBeacon::from_manufacturer_data(*data);
       if (res.has_value())
         return *res;
     }
@@ -109,20 +216,21 @@ class ESPBTDevice {
   }
 
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  void parse_adv_() const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_;
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  mutable bool adv_parsed_{false};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_;
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_{};
 };
 
@@ -177,14 +285,24 @@ class ESP32BLETracker : public Component {
   float get_setup_priority() const override;
 
   void loop() override;
+  bool has_pending_loop_work() override;
 
+  /// Offer all discovered devices to listener.
   void register_listener(ESPBTDeviceListener *listener) {
     listener->set_parent(this);
     this->listeners_.push_back(listener);
   }
+  /// Only offer devices with the given MAC address to listener.
+  void register_listener(ESPBTDeviceListener *listener, uint64_t address);
 
   void register_client(ESPBTClient *client);
 
+  /// Ignore advertisements that are identical to the previous one of the same device for this many ms (0 = never).
+  void set_dedup_interval(uint32_t interval) { this->dedup_interval_ = interval; }
+
+  /// Set how many BLE events can be waiting to be processed by loop(), rounded up to a power of two.
+  void set_event_queue_size(size_t size) { this->event_queue_size_ = size; }
+
   void print_bt_device_info(const ESPBTDevice &device);
 
  protected:
@@ -195,6 +313,8 @@ class ESP32BLETracker : public Component {
   /// Callback that will handle all GAP events and redistribute them to other callbacks.
   static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
   void real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
+  /// Whether the scan result is an unchanged repeat of an advertisement that was handled recently.
+  bool is_duplicate_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event is received.
   void gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT` event is received.
@@ -203,6 +323,8 @@ class ESP32BLETracker : public Component {
   void gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
+  /// Offer the buffered scan results to the listeners and clients.
+  void process_scan_results_();
 
   int app_id_;
   /// Callback that will handle all GATTC events and redistribute them to other callbacks.
@@ -212,6 +334,8 @@ class ESP32BLETracker : public Component {
   /// Vector of addresses that have already been printed in print_bt_device_info
   std::vector<uint64_t> already_discovered_;
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Listeners that are only interested in a single device, sorted by address.
+  std::vector<std::pair<uint64_t, ESPBTDeviceListener *>> address_listeners_;
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
   /// A structure holding the ESP BLE scan parameters.
@@ -228,7 +352,19 @@ class ESP32BLETracker : public Component {
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 
+  /// Events from the Bluetooth task, waiting to be handled in loop()
   Queue<BLEEvent> ble_events_;
+  size_t event_queue_size_{64};
+
+  struct DedupEntry {
+    uint64_t address;
+    uint32_t hash;
+    uint32_t time;
+  };
+  /// Last advertisement of recently seen devices, indexed by a hash of the address.
+  std::array<DedupEntry, 64> dedup_cache_{};
+  uint32_t dedup_interval_{0};
+  uint32_t reported_dropped_events_{0};
 };
 
 // NOLINTNEXTLINE
@@ -4,19 +4,16 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
-#include <queue>
-#include <mutex>
+#include <atomic>
 #include <cstring>
 
 #include <esp_gap_ble_api.h>
 #include <esp_gattc_api.h>
-#include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
 
 /*
  * BLE events come in from a separate Task (thread) in the ESP32 stack. Rather
  * than trying to deal with various locking strategies, all incoming GAP and GATT
- * events will simply be placed on a semaphore guarded queue. The next time the
+ * events will simply be placed on a lock-free queue. The next time the
  * component runs loop(), these events are popped off the queue and handed at
  * this safer time.
  */
@@ -24,41 +21,63 @@
 namespace esphome {
 namespace esp32_ble_tracker {
 
+/** Fixed capacity queue that passes elements from a single producer task to a single consumer task.
+ *
+ * All slots are allocated once by init(), after that neither side blocks or allocates. The producer fills the slot
+ * returned by reserve() and hands it over with commit(), the consumer reads front() and releases it with pop().
+ * Elements that don't fit are dropped and counted.
+ */
 template<class T> class Queue {
  public:
-  Queue() { m_ = xSemaphoreCreateMutex(); }
-
-  void push(T *element) {
-    if (element == nullptr)
-      return;
-    if (xSemaphoreTake(m_, 5L / portTICK_PERIOD_MS)) {
-      q_.push(element);
-      xSemaphoreGive(m_);
-    }
+  /// Allocate the slots, capacity is rounded up to a power of two.
+  void init(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+    this->mask_ = size - 1;
+    this->slots_ = new T[size];  // NOLINT(cppcoreguidelines-owning-memory)
   }
 
-  T *pop() {
-    T *element = nullptr;
-
-    if (xSemaphoreTake(m_, 5L / portTICK_PERIOD_MS)) {
-      if (!q_.empty()) {
-        element = q_.front();
-        q_.pop();
-      }
-      xSemaphoreGive(m_);
+  /// Producer: the slot for the next element, or nullptr if the queue is full.
+  T *reserve() {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail - this->head_.load(std::memory_order_acquire) > this->mask_) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
     }
-    return element;
+    return &this->slots_[tail & this->mask_];
   }
+  /// Producer: make the element in the slot returned by reserve() available to the consumer.
+  void commit() { this->tail_.store(this->tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// Consumer: the oldest element, or nullptr if the queue is empty.
+  T *front() {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head == this->tail_.load(std::memory_order_acquire))
+      return nullptr;
+    return &this->slots_[head & this->mask_];
+  }
+  /// Consumer: release the element returned by front().
+  void pop() { this->head_.store(this->head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// Number of elements that were dropped because the queue was full.
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+  size_t get_capacity() const { return this->mask_ + 1; }
 
  protected:
-  std::queue<T *> q_;
-  SemaphoreHandle_t m_;
+  T *slots_{nullptr};
+  uint32_t mask_{0};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
 };
 
 // Received GAP and GATTC events are only queued, and get processed in the main loop().
 // This class stores each event in a single type.
 class BLEEvent {
  public:
+  BLEEvent() = default;
+
   BLEEvent(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t *p) {
     this->event_.gap.gap_event = e;
     memcpy(&this->event_.gap.gap_param, p, sizeof(esp_ble_gap_cb_param_t));
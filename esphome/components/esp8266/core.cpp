@@ -5,6 +5,7 @@
 #include "preferences.h"
 #include <Arduino.h>
 #include <Esp.h>
+#include <coredecls.h>
 
 namespace esphome {
 
@@ -24,6 +25,14 @@ void arch_init() {}
 void IRAM_ATTR HOT arch_feed_wdt() {
   ESP.wdtFeed();  // NOLINT(readability-static-accessed-through-instance)
 }
+// delay() suspends the loop continuation until its timer fires or esp_schedule() resumes it early.
+bool IRAM_ATTR HOT arch_wait_for_wakeup(uint32_t ms) {
+  ::delay(ms);
+  return false;
+}
+void arch_wake_loop() { esp_schedule(); }
+// esp_schedule() isn't guaranteed to be in IRAM, so interrupts can't wake the loop early.
+void IRAM_ATTR arch_wake_loop_isr() {}
 
 uint8_t progmem_read_byte(const uint8_t *addr) {
   return pgm_read_byte(addr);  // NOLINT
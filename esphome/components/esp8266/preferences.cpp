@@ -6,7 +6,9 @@ extern "C" {
 }
 
 #include "preferences.h"
+#include <algorithm>
 #include <cstring>
+#include <memory>
 #include "esphome/core/preferences.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
@@ -20,6 +22,11 @@ static const char *const TAG = "esp8266.preferences";
 static bool s_prevent_write = false;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static uint32_t *s_flash_storage = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static bool s_flash_dirty = false;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Range of words in s_flash_storage changed since the last sync.
+static uint32_t s_flash_dirty_begin = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_flash_dirty_end = 0;    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Word offset in the flash sector where the next log record is appended.
+static uint32_t s_flash_log_offset = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 static const uint32_t ESP_RTC_USER_MEM_START = 0x60001200;
 #define ESP_RTC_USER_MEM ((uint32_t *) ESP_RTC_USER_MEM_START)
@@ -65,6 +72,18 @@ static uint32_t get_esp8266_flash_sector() {
 }
 static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
+// The flash sector is used as an append-only log of records, so that a sync only has to write the changed words
+// and the sector is only erased once it is full. Each record consists of a header word, the data words and a CRC
+// word. Erased flash (0xFFFFFFFF) marks the end of the log.
+static const uint32_t ESP8266_FLASH_LOG_SIZE = SPI_FLASH_SEC_SIZE / 4;  // in words
+static const uint32_t ESP8266_FLASH_LOG_MAGIC = 0x5E000000;
+static const uint32_t ESP8266_FLASH_LOG_MAGIC_MASK = 0xFF000000;
+static const uint32_t ESP8266_FLASH_LOG_ERASED = 0xFFFFFFFF;
+
+static inline uint32_t flash_log_header(uint32_t offset, uint32_t length) {
+  return ESP8266_FLASH_LOG_MAGIC | (offset << 8) | length;
+}
+
 template<class It> uint32_t calculate_crc(It first, It last, uint32_t type) {
   uint32_t crc = type;
   while (first != last) {
@@ -80,8 +99,16 @@ static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
       return false;
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
-    if (*ptr != v)
+    if (*ptr != v) {
+      if (!s_flash_dirty) {
+        s_flash_dirty_begin = j;
+        s_flash_dirty_end = j + 1;
+      } else {
+        s_flash_dirty_begin = std::min(s_flash_dirty_begin, j);
+        s_flash_dirty_end = std::max(s_flash_dirty_end, j + 1);
+      }
       s_flash_dirty = true;
+    }
     *ptr = v;
   }
   return true;
@@ -167,7 +194,9 @@ class ESP8266Preferences : public ESPPreferences {
     s_flash_storage = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];  // NOLINT
     ESP_LOGVV(TAG, "Loading preferences from flash...");
 
-    {
+    if (!this->load_log_()) {
+      // Not (completely) in log format, e.g. written by an older version that stored a plain copy of the storage.
+      // Load it like that, a failing CRC check rejects any garbage. The next sync compacts it into the log format.
       InterruptLock lock;
       spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
     }
@@ -231,27 +260,108 @@ class ESP8266Preferences : public ESPPreferences {
     if (s_prevent_write)
       return false;
 
-    ESP_LOGD(TAG, "Saving preferences to flash...");
-    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
+    uint32_t begin = s_flash_dirty_begin;
+    uint32_t length = s_flash_dirty_end - s_flash_dirty_begin;
+    bool compact = s_flash_log_offset + length + 2 > ESP8266_FLASH_LOG_SIZE;
+    if (compact) {
+      // Log is full, erase the sector and start over with a single record of the complete storage
+      begin = 0;
+      length = ESP8266_FLASH_STORAGE_SIZE;
+      s_flash_log_offset = 0;
+    }
+
+    ESP_LOGD(TAG, "Saving preferences to flash (%u words at log offset %u%s)...", length, s_flash_log_offset,
+             compact ? ", sector erased" : "");
+    uint32_t header = flash_log_header(begin, length);
+    uint32_t crc = calculate_crc(s_flash_storage + begin, s_flash_storage + begin + length, header);
+    const uint32_t address = get_esp8266_flash_address() + s_flash_log_offset * 4;
+    SpiFlashOpResult erase_res = SPI_FLASH_RESULT_OK, write_res = SPI_FLASH_RESULT_OK;
     {
       InterruptLock lock;
-      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
-      if (erase_res == SPI_FLASH_RESULT_OK) {
-        write_res = spi_flash_write(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
-      }
+      if (compact)
+        erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+      if (erase_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address, &header, 4);
+      if (erase_res == SPI_FLASH_RESULT_OK && write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address + 4, s_flash_storage + begin, length * 4);
+      if (erase_res == SPI_FLASH_RESULT_OK && write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address + 4 + length * 4, &crc, 4);
     }
     if (erase_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
+      // Sector is in an unknown state, make sure the next attempt starts with an erase again.
+      s_flash_log_offset = ESP8266_FLASH_LOG_SIZE;
       return false;
     }
     if (write_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGV(TAG, "Write ESP8266 flash failed!");
+      s_flash_log_offset = ESP8266_FLASH_LOG_SIZE;
       return false;
     }
 
+    s_flash_log_offset += length + 2;
     s_flash_dirty = false;
     return true;
   }
+
+ protected:
+  /// Replay the records in the flash log into s_flash_storage. Returns false if the sector isn't in log format.
+  bool load_log_() {
+    for (uint32_t i = 0; i < ESP8266_FLASH_STORAGE_SIZE; i++)
+      s_flash_storage[i] = ESP8266_FLASH_LOG_ERASED;
+
+    std::unique_ptr<uint32_t[]> record(new uint32_t[ESP8266_FLASH_STORAGE_SIZE + 1]);  // NOLINT
+    const uint32_t address = get_esp8266_flash_address();
+    uint32_t offset = 0;
+    uint32_t records = 0;
+    while (offset < ESP8266_FLASH_LOG_SIZE) {
+      uint32_t header;
+      {
+        InterruptLock lock;
+        spi_flash_read(address + offset * 4, &header, 4);
+      }
+      if (header == ESP8266_FLASH_LOG_ERASED)
+        break;
+
+      const uint32_t begin = (header >> 8) & 0xFFFF;
+      const uint32_t length = header & 0xFF;
+      bool valid = (header & ESP8266_FLASH_LOG_MAGIC_MASK) == ESP8266_FLASH_LOG_MAGIC && length != 0 &&
+                   begin + length <= ESP8266_FLASH_STORAGE_SIZE && offset + length + 2 <= ESP8266_FLASH_LOG_SIZE;
+      if (valid) {
+        {
+          InterruptLock lock;
+          // read the data and CRC words in one go
+          spi_flash_read(address + offset * 4 + 4, record.get(), (length + 1) * 4);
+        }
+        valid = record[length] == calculate_crc(record.get(), record.get() + length, header);
+      }
+      if (!valid) {
+        if (records == 0) {
+          s_flash_log_offset = ESP8266_FLASH_LOG_SIZE;
+          return false;
+        }
+        // Probably a partially written record from a power loss during sync, everything before it is still good.
+        // Don't append after the garbage, compact the log on the next sync instead.
+        ESP_LOGW(TAG, "Corrupt preferences log record at offset %u, ignoring the rest of the log", offset);
+        offset = ESP8266_FLASH_LOG_SIZE;
+        break;
+      }
+
+      memcpy(s_flash_storage + begin, record.get(), length * 4);
+      offset += length + 2;
+      records++;
+    }
+
+    if (records == 0) {
+      // Erased sector, or an older version wrote a plain copy of the storage that happens to start with an erased
+      // word. Either way, start a fresh log on the next sync.
+      s_flash_log_offset = ESP8266_FLASH_LOG_SIZE;
+      return false;
+    }
+    ESP_LOGV(TAG, "Loaded %u preferences log records, %u/%u words used", records, offset, ESP8266_FLASH_LOG_SIZE);
+    s_flash_log_offset = offset;
+    return true;
+  }
 };
 
 void setup_preferences() {
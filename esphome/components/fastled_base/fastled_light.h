@@ -228,6 +228,16 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  light::PixelBufferLayout get_pixel_buffer_layout_() const override {
+    light::PixelBufferLayout layout;
+    layout.data = reinterpret_cast<uint8_t *>(this->leds_);
+    layout.stride = sizeof(CRGB);
+    layout.red = offsetof(CRGB, r);
+    layout.green = offsetof(CRGB, g);
+    layout.blue = offsetof(CRGB, b);
+    layout.effect_data = this->effect_data_;
+    return layout;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
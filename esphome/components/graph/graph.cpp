@@ -17,7 +17,7 @@ static const char *const TAGL = "graphlegend";
 
 void HistoryData::init(int length) {
   this->length_ = length;
-  this->samples_.resize(length, NAN);
+  this->buckets_.resize(length, HistoryBucket{NAN, NAN, NAN});
   this->last_sample_ = millis();
 }
 
@@ -26,32 +26,67 @@ void HistoryData::take_sample(float data) {
   uint32_t dt = tm - last_sample_;
   last_sample_ = tm;
 
+  if (!std::isnan(data)) {
+    if (this->open_count_ == 0) {
+      this->open_min_ = data;
+      this->open_max_ = data;
+      this->open_sum_ = 0.0f;
+    }
+    this->open_min_ = std::min(this->open_min_, data);
+    this->open_max_ = std::max(this->open_max_, data);
+    this->open_sum_ += data;
+    this->open_count_++;
+
+    if (std::isnan(this->recent_min_) || data < this->recent_min_)
+      this->recent_min_ = data;
+    if (std::isnan(this->recent_max_) || data > this->recent_max_)
+      this->recent_max_ = data;
+  }
+
   // Step data based on time
   this->period_ += dt;
   while (this->period_ >= this->update_time_) {
-    this->samples_[this->count_] = data;
+    this->close_column_(data);
     this->period_ -= this->update_time_;
-    this->count_ = (this->count_ + 1) % this->length_;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
-  if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+}
+
+void HistoryData::close_column_(float data) {
+  HistoryBucket &bucket = this->buckets_[this->count_];
+  // Only a column holding the recent minimum or maximum can change them when it's dropped
+  const bool evicts_extreme = bucket.min == this->recent_min_ || bucket.max == this->recent_max_;
+  if (this->open_count_ > 0) {
+    bucket = HistoryBucket{this->open_min_, this->open_max_, this->open_sum_ / this->open_count_};
+    this->open_count_ = 0;
+  } else {
+    // No sample during this column, repeat the last one
+    bucket = HistoryBucket{data, data, data};
+  }
+  this->count_ = (this->count_ + 1) % this->length_;
+  this->columns_++;
+  if (evicts_extreme)
+    this->update_recent_range_();
+}
+
+void HistoryData::update_recent_range_() {
+  this->recent_min_ = this->open_count_ > 0 ? this->open_min_ : NAN;
+  this->recent_max_ = this->open_count_ > 0 ? this->open_max_ : NAN;
+  for (auto &bucket : this->buckets_) {
+    if (std::isnan(bucket.avg))
+      continue;
+    if (std::isnan(this->recent_min_) || bucket.min < this->recent_min_)
+      this->recent_min_ = bucket.min;
+    if (std::isnan(this->recent_max_) || bucket.max > this->recent_max_)
+      this->recent_max_ = bucket.max;
   }
 }
 
 void GraphTrace::init(Graph *g) {
   ESP_LOGI(TAG, "Init trace for sensor %s", this->get_name().c_str());
   this->data_.init(g->get_width());
+  this->y_top_.resize(g->get_width(), 1);
+  this->y_bottom_.resize(g->get_width(), 0);
   sensor_->add_on_state_callback([this](float state) { this->data_.take_sample(state); });
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
 }
@@ -155,20 +190,47 @@ void Graph::draw(DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Colo
 
   /// Draw traces
   ESP_LOGV(TAG, "Updating graph. ymin %f, ymax %f", ymin, ymax);
+  // Pixel rows of columns are only calculated again when the y-axis changed, otherwise just for new columns
+  const bool range_changed = ymin != this->rendered_ymin_ || ymax != this->rendered_ymax_;
+  this->rendered_ymin_ = ymin;
+  this->rendered_ymax_ = ymax;
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
+    const HistoryData *data = trace->get_tracedata();
+    if (thick == 0)
+      continue;
+
+    const uint32_t columns = data->get_columns();
+    uint32_t changed = columns - trace->rendered_columns_;
+    if (range_changed || changed > this->width_)
+      changed = this->width_;
+    trace->rendered_columns_ = columns;
+    for (uint32_t i = 0; i < changed; i++) {
+      const HistoryBucket &bucket = data->get_bucket(i);
+      const int index = data->get_index(i);
+      float top = (bucket.max - ymin) / yrange;
+      float bottom = (bucket.min - ymin) / yrange;
+      if (!std::isfinite(top) || !std::isfinite(bottom)) {
+        trace->y_top_[index] = 1;
+        trace->y_bottom_[index] = 0;
+        continue;
+      }
+      // Span from the column's maximum to its minimum, so that short peaks stay visible
+      trace->y_top_[index] = (int16_t) roundf((this->height_ - 1) * (1.0 - top)) - thick / 2;
+      trace->y_bottom_[index] = (int16_t) roundf((this->height_ - 1) * (1.0 - bottom)) - thick / 2 + thick - 1;
+    }
+
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
-        int16_t x = this->width_ - 1 - i;
-        uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
-        if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
-          for (uint16_t t = 0; t < thick; t++) {
-            buff->draw_pixel_at(x_offset + x, y_offset + y + t, c);
-          }
-        }
+      const int index = data->get_index(i);
+      const int16_t y_top = trace->y_top_[index];
+      const int16_t y_bottom = trace->y_bottom_[index];
+      if (y_top > y_bottom)
+        continue;
+      int16_t x = this->width_ - 1 - i;
+      uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
+      if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
+        buff->vertical_line(x_offset + x, y_offset + y_top, y_bottom - y_top + 1, c);
       }
     }
   }
@@ -82,6 +82,13 @@ class GraphLegend {
   friend Graph;
 };
 
+/// Summary of the samples taken during one column of the graph.
+struct HistoryBucket {
+  float min;
+  float max;
+  float avg;
+};
+
 class HistoryData {
  public:
   void init(int length);
@@ -89,19 +96,34 @@ class HistoryData {
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
+  /// Average of the column idx columns before the most recent one.
+  float get_value(int idx) const { return this->get_bucket(idx).avg; }
+  const HistoryBucket &get_bucket(int idx) const { return buckets_[this->get_index(idx)]; }
+  /// Index into the ring of columns of the column idx columns before the most recent one.
+  int get_index(int idx) const { return (count_ + length_ - 1 - idx) % length_; }
+  /// Total number of columns completed, increases whenever a column is added.
+  uint32_t get_columns() const { return columns_; }
   float get_recent_max() const { return recent_max_; }
   float get_recent_min() const { return recent_min_; }
 
  protected:
+  void close_column_(float data);
+  void update_recent_range_();
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
   int length_;
   int count_{0};
+  uint32_t columns_{0};
   float recent_min_{NAN};
   float recent_max_{NAN};
-  std::vector<float> samples_;
+  std::vector<HistoryBucket> buckets_;
+  // Samples of the column that isn't complete yet
+  float open_min_{NAN};
+  float open_max_{NAN};
+  float open_sum_{0.0f};
+  uint32_t open_count_{0};
 };
 
 class GraphTrace {
@@ -125,6 +147,11 @@ class GraphTrace {
   enum LineType line_type_ { LINE_TYPE_SOLID };
   Color line_color_{COLOR_ON};
   HistoryData data_;
+  // Cached pixel rows of every column, indexed like the columns of data_. Empty columns have top > bottom.
+  std::vector<int16_t> y_top_;
+  std::vector<int16_t> y_bottom_;
+  /// Number of columns of data_ that have been converted to pixel rows.
+  uint32_t rendered_columns_{0};
 
   friend Graph;
   friend GraphLegend;
@@ -171,6 +198,9 @@ class Graph : public Component {
   bool border_{true};
   std::vector<GraphTrace *> traces_;
   GraphLegend *legend_{nullptr};
+  // Y-axis range the cached trace pixel rows were calculated for
+  float rendered_ymin_{NAN};
+  float rendered_ymax_{NAN};
 
   friend GraphLegend;
 };
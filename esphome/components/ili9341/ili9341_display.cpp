@@ -86,12 +86,15 @@ void ILI9341Display::update() {
 
 void ILI9341Display::display_() {
   // we will only update the changed window to the display
-  uint16_t w = this->x_high_ - this->x_low_ + 1;
-  uint16_t h = this->y_high_ - this->y_low_ + 1;
+  int x1, y1, x2, y2;
+  if (!this->take_dirty_region_(&x1, &y1, &x2, &y2) || !this->skip_unchanged_lines_(&y1, &y2, this->width_))
+    return;
+  uint16_t w = x2 - x1 + 1;
+  uint16_t h = y2 - y1 + 1;
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+  set_addr_window_(x1, y1, w, h);
   this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
+  uint32_t start_pos = ((y1 * this->width_) + x1);
   for (uint16_t row = 0; row < h; row++) {
     uint32_t pos = start_pos + (row * width_);
     uint32_t rem = w;
@@ -104,12 +107,6 @@ void ILI9341Display::display_() {
     }
   }
   this->end_data_();
-
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) {
@@ -134,11 +131,22 @@ uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
 
 void ILI9341Display::fill(Color color) {
   auto color565 = display::ColorUtil::color_to_565(color);
-  memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  uint8_t color8 = convert_to_8bit_color_(color565);
+  // only mark the rows that actually change as dirty, so that redrawing a static background doesn't cause a full
+  // refresh
+  const uint32_t length = this->get_buffer_length_();
+  uint32_t first = 0;
+  while (first < length && this->buffer_[first] == color8)
+    first++;
+  if (first == length)
+    return;
+  uint32_t last = length - 1;
+  while (this->buffer_[last] == color8)
+    last--;
+
+  memset(this->buffer_, color8, length);
+  this->mark_dirty_(0, first / this->width_);
+  this->mark_dirty_(this->width_ - 1, last / this->width_);
 }
 
 void ILI9341Display::fill_internal_(Color color) {
@@ -168,21 +176,45 @@ void ILI9341Display::fill_internal_(Color color) {
   this->end_data_();
 
   memset(buffer_, 0, (this->get_width_internal()) * (this->get_height_internal()));
+  // buffer and display memory are in sync now, but the hashes still describe what was shown before
+  this->clear_dirty_region_();
+  this->reset_line_hashes_();
 }
 
 void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-
   uint32_t pos = (y * width_) + x;
   auto color565 = display::ColorUtil::color_to_565(color);
-  buffer_[pos] = convert_to_8bit_color_(color565);
+  uint8_t color8 = convert_to_8bit_color_(color565);
+  if (buffer_[pos] == color8)
+    return;
+  buffer_[pos] = color8;
+  // only send the window of changed pixels to the display
+  this->mark_dirty_(x, y);
+}
+
+void HOT ILI9341Display::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+    return;
+
+  auto color565 = display::ColorUtil::color_to_565(color);
+  uint8_t color8 = convert_to_8bit_color_(color565);
+  bool changed = false;
+  for (int row = y; row < y + height; row++) {
+    uint8_t *dst = this->buffer_ + row * this->width_ + x;
+    for (int i = 0; i < width; i++) {
+      if (dst[i] != color8) {
+        dst[i] = color8;
+        changed = true;
+      }
+    }
+  }
+  if (changed) {
+    this->mark_dirty_(x, y);
+    this->mark_dirty_(x + width - 1, y + height - 1);
+  }
 }
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
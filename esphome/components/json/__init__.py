@@ -1,10 +1,16 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.core import coroutine_with_priority
+from esphome.core import CORE, coroutine_with_priority
 
 CODEOWNERS = ["@OttoWinter"]
 json_ns = cg.esphome_ns.namespace("json")
 
+KEY_JSON = "json"
+KEY_PARSE_CAPACITY = "parse_capacity"
+
+# Size of the buffer incoming JSON documents are parsed into if no component asks for a specific size.
+DEFAULT_PARSE_CAPACITY = 512
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema({}),
 )
@@ -15,3 +21,17 @@ async def to_code(config):
     cg.add_library("bblanchon/ArduinoJson", "6.18.5")
     cg.add_define("USE_JSON")
     cg.add_global(json_ns.using)
+    cg.add_define("JSON_PARSE_CAPACITY", get_parse_capacity())
+
+
+def request_parse_capacity(capacity):
+    """Make sure incoming JSON documents of at least capacity bytes (ArduinoJson pool size) can be parsed.
+
+    Must be called from a to_code with a priority higher than the json component's.
+    """
+    data = CORE.data.setdefault(KEY_JSON, {})
+    data[KEY_PARSE_CAPACITY] = max(data.get(KEY_PARSE_CAPACITY, 0), capacity)
+
+
+def get_parse_capacity():
+    return CORE.data.get(KEY_JSON, {}).get(KEY_PARSE_CAPACITY, DEFAULT_PARSE_CAPACITY)
@@ -1,5 +1,10 @@
 #include "json_util.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
 
 #ifdef USE_ESP8266
 #include <Esp.h>
@@ -15,48 +20,209 @@ static const char *const TAG = "json";
 
 static std::vector<char> global_json_build_buffer;  // NOLINT
 
+// Capacity that was enough for the largest document built so far, used as the first guess for the next one.
+static size_t json_build_capacity = 512;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 std::string build_json(const json_build_t &f) {
-  // Here we are allocating as much heap memory as available minus 2kb to be safe
-  // as we can not have a true dynamic sized document.
-  // The excess memory is freed below with `shrinkToFit()`
+  // Instead of allocating as much memory as available for every document (which fragments the heap), start with
+  // the capacity that was sufficient before and only grow it when the document doesn't fit.
 #ifdef USE_ESP8266
-  const size_t free_heap = ESP.getMaxFreeBlockSize() - 2048;  // NOLINT(readability-static-accessed-through-instance)
+  const size_t max_capacity = ESP.getMaxFreeBlockSize() - 2048;  // NOLINT(readability-static-accessed-through-instance)
 #elif defined(USE_ESP32)
-  const size_t free_heap = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT) - 2048;
+  const size_t max_capacity = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT) - 2048;
 #endif
 
-  DynamicJsonDocument json_document(free_heap);
-  JsonObject root = json_document.to<JsonObject>();
-  f(root);
-  json_document.shrinkToFit();
+  size_t capacity = std::min(json_build_capacity, max_capacity);
+  while (true) {
+    DynamicJsonDocument json_document(capacity);
+    JsonObject root = json_document.to<JsonObject>();
+    f(root);
+
+    if (json_document.overflowed() && capacity < max_capacity) {
+      // Retry with as much memory as available right away, so that f is called at most twice
+      capacity = max_capacity;
+      continue;
+    }
+    if (json_document.overflowed()) {
+      ESP_LOGW(TAG, "JSON document too large for available memory, output is truncated.");
+    } else {
+      while (json_build_capacity < json_document.memoryUsage())
+        json_build_capacity *= 2;
+    }
 
-  std::string output;
-  serializeJson(json_document, output);
-  return output;
+    std::string output;
+    output.reserve(measureJson(json_document));
+    serializeJson(json_document, output);
+    return output;
+  }
 }
 
-void parse_json(const std::string &data, const json_parse_t &f) {
-  // Here we are allocating as much heap memory as available minus 2kb to be safe
-  // as we can not have a true dynamic sized document.
-  // The excess memory is freed below with `shrinkToFit()`
-#ifdef USE_ESP8266
-  const size_t free_heap = ESP.getMaxFreeBlockSize() - 2048;  // NOLINT(readability-static-accessed-through-instance)
-#elif defined(USE_ESP32)
-  const size_t free_heap = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT) - 2048;
-#endif
+JsonWriter::JsonWriter(std::string &out) : out_(out) { this->out_ += '{'; }
+JsonWriter &JsonWriter::begin_object(const char *key) {
+  this->key_(key);
+  this->out_ += '{';
+  this->depth_++;
+  this->first_ = true;
+  return *this;
+}
+JsonWriter &JsonWriter::end_object() {
+  if (this->depth_ > 0) {
+    this->out_ += '}';
+    this->depth_--;
+    this->first_ = false;
+  }
+  return *this;
+}
+JsonWriter &JsonWriter::add(const char *key, const char *value) {
+  this->key_(key);
+  this->string_(value, strlen(value));
+  return *this;
+}
+JsonWriter &JsonWriter::add(const char *key, const std::string &value) {
+  this->key_(key);
+  this->string_(value.data(), value.size());
+  return *this;
+}
+JsonWriter &JsonWriter::add(const char *key, bool value) {
+  this->key_(key);
+  this->out_ += value ? "true" : "false";
+  return *this;
+}
+JsonWriter &JsonWriter::add_signed_(const char *key, int32_t value) {
+  this->key_(key);
+  char buf[12];
+  snprintf(buf, sizeof(buf), "%" PRId32, value);
+  this->out_ += buf;
+  return *this;
+}
+JsonWriter &JsonWriter::add_unsigned_(const char *key, uint32_t value) {
+  this->key_(key);
+  char buf[12];
+  snprintf(buf, sizeof(buf), "%" PRIu32, value);
+  this->out_ += buf;
+  return *this;
+}
+JsonWriter &JsonWriter::add_signed64_(const char *key, int64_t value) {
+  this->key_(key);
+  if (value < 0) {
+    this->out_ += '-';
+    // negate as unsigned, so that the minimum value doesn't overflow
+    this->uint64_(0 - static_cast<uint64_t>(value));
+  } else {
+    this->uint64_(value);
+  }
+  return *this;
+}
+JsonWriter &JsonWriter::add_unsigned64_(const char *key, uint64_t value) {
+  this->key_(key);
+  this->uint64_(value);
+  return *this;
+}
+JsonWriter &JsonWriter::add(const char *key, float value) { return this->add_number_(key, value, "%.7g"); }
+JsonWriter &JsonWriter::add(const char *key, double value) { return this->add_number_(key, value, "%.15g"); }
+JsonWriter &JsonWriter::add_number_(const char *key, double value, const char *format) {
+  this->key_(key);
+  if (std::isnan(value) || std::isinf(value)) {
+    // not representable in JSON
+    this->out_ += "null";
+    return *this;
+  }
+  char buf[32];
+  snprintf(buf, sizeof(buf), format, value);
+  this->out_ += buf;
+  return *this;
+}
+std::string &JsonWriter::finish() {
+  while (this->depth_ > 0)
+    this->end_object();
+  return this->out_;
+}
+void JsonWriter::key_(const char *key) {
+  if (!this->first_)
+    this->out_ += ',';
+  this->first_ = false;
+  this->string_(key, strlen(key));
+  this->out_ += ':';
+}
+void JsonWriter::uint64_(uint64_t value) {
+  // printf doesn't support 64 bit integers on all platforms
+  char buf[20];
+  char *start = buf + sizeof(buf);
+  do {
+    *--start = char('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  this->out_.append(start, buf + sizeof(buf) - start);
+}
+void JsonWriter::string_(const char *value, size_t length) {
+  this->out_ += '"';
+  for (size_t i = 0; i < length; i++) {
+    const char c = value[i];
+    switch (c) {
+      case '"':
+        this->out_ += "\\\"";
+        break;
+      case '\\':
+        this->out_ += "\\\\";
+        break;
+      case '\n':
+        this->out_ += "\\n";
+        break;
+      case '\r':
+        this->out_ += "\\r";
+        break;
+      case '\t':
+        this->out_ += "\\t";
+        break;
+      default:
+        if (static_cast<uint8_t>(c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          this->out_ += buf;
+        } else {
+          this->out_ += c;
+        }
+        break;
+    }
+  }
+  this->out_ += '"';
+}
 
-  DynamicJsonDocument json_document(free_heap);
+static void parse_json_into(JsonDocument &json_document, const std::string &data, const json_parse_t &f) {
   DeserializationError err = deserializeJson(json_document, data);
-  json_document.shrinkToFit();
+  if (err == DeserializationError::NoMemory) {
+    ESP_LOGW(TAG, "JSON document of %zu bytes doesn't fit in the %zu byte parse buffer, ignoring it.", data.size(),
+             json_document.capacity());
+    return;
+  }
+  if (err) {
+    ESP_LOGW(TAG, "Parsing JSON failed: %s", err.c_str());
+    return;
+  }
 
-  JsonObject root = json_document.as<JsonObject>();
+  f(json_document.as<JsonObject>());
+}
 
-  if (err) {
-    ESP_LOGW(TAG, "Parsing JSON failed.");
+void parse_json(const std::string &data, const json_parse_t &f) {
+  // Incoming documents are parsed into a single buffer that is allocated on first use and reused afterwards, instead
+  // of grabbing (and fragmenting) the largest free heap block for every message. Its capacity is chosen at compile
+  // time from the documents the enabled components expect; anything that doesn't fit is rejected.
+  static DynamicJsonDocument *parse_document = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static bool parsing = false;                           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  if (parsing) {
+    // Only happens when a parse callback parses another document; give that one a buffer of its own.
+    DynamicJsonDocument json_document(JSON_PARSE_CAPACITY);
+    parse_json_into(json_document, data, f);
     return;
   }
+  if (parse_document == nullptr)
+    parse_document = new DynamicJsonDocument(JSON_PARSE_CAPACITY);  // NOLINT(cppcoreguidelines-owning-memory)
 
-  f(root);
+  parsing = true;
+  parse_json_into(*parse_document, data, f);
+  parse_document->clear();
+  parsing = false;
 }
 
 }  // namespace json
@@ -18,10 +18,69 @@ using json_parse_t = std::function<void(JsonObject)>;
 /// Callback function typedef for building JsonObjects.
 using json_build_t = std::function<void(JsonObject)>;
 
-/// Build a JSON string with the provided json build function.
+/** Build a JSON string with the provided json build function.
+ *
+ * The document starts small and is built again when it doesn't fit, so f can be called twice. It must only fill in
+ * the object and not have other side effects.
+ */
 std::string build_json(const json_build_t &f);
 
-/// Parse a JSON string and run the provided json parse function if it's valid.
+/** Streaming JSON writer that appends directly to a string, without building a JsonDocument first.
+ *
+ * Meant for the small documents that are built for every state change, so they don't need any allocations other
+ * than the output string (which can be reused by the caller). Keys and values are written in the order they are
+ * added, duplicate keys aren't detected.
+ */
+class JsonWriter {
+ public:
+  /// Start writing a JSON object to out, after whatever out already contains.
+  explicit JsonWriter(std::string &out);
+
+  /// Start a nested object with the given key, close it with end_object().
+  JsonWriter &begin_object(const char *key);
+  JsonWriter &end_object();
+
+  JsonWriter &add(const char *key, const char *value);
+  JsonWriter &add(const char *key, const std::string &value);
+  JsonWriter &add(const char *key, bool value);
+  JsonWriter &add(const char *key, float value);
+  JsonWriter &add(const char *key, double value);
+  template<typename T, enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value, int> = 0>
+  JsonWriter &add(const char *key, T value) {
+    if (sizeof(T) > sizeof(uint32_t)) {
+      if (std::is_signed<T>::value)
+        return this->add_signed64_(key, value);
+      return this->add_unsigned64_(key, value);
+    }
+    if (std::is_signed<T>::value)
+      return this->add_signed_(key, value);
+    return this->add_unsigned_(key, value);
+  }
+
+  /// Close all open objects and return the output.
+  std::string &finish();
+
+ protected:
+  JsonWriter &add_signed_(const char *key, int32_t value);
+  JsonWriter &add_unsigned_(const char *key, uint32_t value);
+  JsonWriter &add_signed64_(const char *key, int64_t value);
+  JsonWriter &add_unsigned64_(const char *key, uint64_t value);
+  JsonWriter &add_number_(const char *key, double value, const char *format);
+  void key_(const char *key);
+  void uint64_(uint64_t value);
+  void string_(const char *value, size_t length);
+
+  std::string &out_;
+  uint8_t depth_{1};
+  bool first_{true};
+};
+
+/** Parse a JSON string and run the provided json parse function if it's valid.
+ *
+ * Documents are parsed into a reusable buffer of JSON_PARSE_CAPACITY bytes, which is sized at compile time from the
+ * components that parse JSON (see request_parse_capacity() in the json component). Documents that don't fit are
+ * rejected with a warning. The JsonObject passed to f is only valid until f returns.
+ */
 void parse_json(const std::string &data, const json_parse_t &f);
 
 }  // namespace json
@@ -48,6 +48,110 @@ void AddressableLight::update_state(LightState *state) {
   this->schedule_show();
 }
 
+void AddressableLight::fill(int32_t from, int32_t to, const Color &color) {
+  from = interpret_index(from, this->size());
+  to = interpret_index(to, this->size());
+  const PixelBufferLayout layout = this->get_pixel_buffer_layout_();
+  if (layout.data == nullptr) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i).set(color);
+    return;
+  }
+
+  const Color corrected = this->correction_.color_correct(color);
+  uint8_t *pixel = layout.data + layout.stride * from;
+  for (int32_t i = from; i < to; i++, pixel += layout.stride) {
+    pixel[layout.red] = corrected.red;
+    pixel[layout.green] = corrected.green;
+    pixel[layout.blue] = corrected.blue;
+    if (layout.white >= 0)
+      pixel[layout.white] = corrected.white;
+  }
+}
+void AddressableLight::write(int32_t from, const Color *colors, int32_t count) {
+  from = interpret_index(from, this->size());
+  const PixelBufferLayout layout = this->get_pixel_buffer_layout_();
+  if (layout.data == nullptr) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(from + i).set(colors[i]);
+    return;
+  }
+
+  uint8_t *pixel = layout.data + layout.stride * from;
+  for (int32_t i = 0; i < count; i++, pixel += layout.stride) {
+    const Color corrected = this->correction_.color_correct(colors[i]);
+    pixel[layout.red] = corrected.red;
+    pixel[layout.green] = corrected.green;
+    pixel[layout.blue] = corrected.blue;
+    if (layout.white >= 0)
+      pixel[layout.white] = corrected.white;
+  }
+}
+void AddressableLight::read(int32_t from, Color *colors, int32_t count) const {
+  from = interpret_index(from, this->size());
+  const PixelBufferLayout layout = this->get_pixel_buffer_layout_();
+  if (layout.data == nullptr) {
+    for (int32_t i = 0; i < count; i++)
+      colors[i] = this->get_view_internal(from + i).get();
+    return;
+  }
+
+  const uint8_t *pixel = layout.data + layout.stride * from;
+  for (int32_t i = 0; i < count; i++, pixel += layout.stride) {
+    colors[i].red = this->correction_.color_uncorrect_red(pixel[layout.red]);
+    colors[i].green = this->correction_.color_uncorrect_green(pixel[layout.green]);
+    colors[i].blue = this->correction_.color_uncorrect_blue(pixel[layout.blue]);
+    colors[i].white = layout.white >= 0 ? this->correction_.color_uncorrect_white(pixel[layout.white]) : 0;
+  }
+}
+void AddressableLight::scale(int32_t from, int32_t to, uint8_t scale) {
+  from = interpret_index(from, this->size());
+  to = interpret_index(to, this->size());
+  const PixelBufferLayout layout = this->get_pixel_buffer_layout_();
+  if (layout.data == nullptr) {
+    for (int32_t i = from; i < to; i++) {
+      auto view = this->get_view_internal(i);
+      view = view.get() * scale;
+    }
+    return;
+  }
+
+  const ESPColorCorrection &correction = this->correction_;
+  uint8_t *pixel = layout.data + layout.stride * from;
+  for (int32_t i = from; i < to; i++, pixel += layout.stride) {
+    uint8_t &red = pixel[layout.red];
+    uint8_t &green = pixel[layout.green];
+    uint8_t &blue = pixel[layout.blue];
+    red = correction.color_correct_red(esp_scale8(correction.color_uncorrect_red(red), scale));
+    green = correction.color_correct_green(esp_scale8(correction.color_uncorrect_green(green), scale));
+    blue = correction.color_correct_blue(esp_scale8(correction.color_uncorrect_blue(blue), scale));
+    if (layout.white >= 0) {
+      uint8_t &white = pixel[layout.white];
+      white = correction.color_correct_white(esp_scale8(correction.color_uncorrect_white(white), scale));
+    }
+  }
+}
+void AddressableLight::read_effect_data(int32_t from, uint8_t *data, int32_t count) const {
+  from = interpret_index(from, this->size());
+  const PixelBufferLayout layout = this->get_pixel_buffer_layout_();
+  if (layout.effect_data == nullptr) {
+    for (int32_t i = 0; i < count; i++)
+      data[i] = this->get_view_internal(from + i).get_effect_data();
+    return;
+  }
+  memcpy(data, layout.effect_data + from, count);
+}
+void AddressableLight::write_effect_data(int32_t from, const uint8_t *data, int32_t count) {
+  from = interpret_index(from, this->size());
+  const PixelBufferLayout layout = this->get_pixel_buffer_layout_();
+  if (layout.effect_data == nullptr) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(from + i).set_effect_data(data[i]);
+    return;
+  }
+  memcpy(layout.effect_data + from, data, count);
+}
+
 void AddressableLightTransformer::start() {
   // don't try to transition over running effects.
   if (this->light_.is_effect_active())
@@ -22,6 +22,18 @@ using ESPColor ESPDEPRECATED("esphome::light::ESPColor is deprecated, use esphom
 /// Convert the color information from a `LightColorValues` object to a `Color` object (does not apply brightness).
 Color color_from_light_color_values(LightColorValues val);
 
+/// Location of the channels of pixel 0 in the raw output buffer of an addressable light, the channels of pixel i are
+/// stride * i bytes further. Used by the bulk operations to bypass ESPColorView.
+struct PixelBufferLayout {
+  uint8_t *data{nullptr};  ///< nullptr if the light doesn't have a single contiguous buffer.
+  uint8_t stride{0};
+  uint8_t red{0};
+  uint8_t green{0};
+  uint8_t blue{0};
+  int8_t white{-1};  ///< -1 if the light doesn't have a white channel.
+  uint8_t *effect_data{nullptr};  ///< One byte per pixel.
+};
+
 /// Use a custom state class for addressable lights, to allow type system to discriminate between addressable and
 /// non-addressable lights.
 class AddressableLightState : public LightState {
@@ -60,6 +72,23 @@ class AddressableLight : public LightOutput, public Component {
       amnt = this->size();
     this->range(amnt, this->size()) = this->range(0, -amnt);
   }
+
+  // Bulk operations, these apply color correction in a single loop over the output buffer instead of going through an
+  // ESPColorView for every LED. Indices are interpreted like range().
+
+  /// Set all LEDs in [from, to) to color.
+  void fill(int32_t from, int32_t to, const Color &color);
+  /// Set count LEDs starting at from to colors.
+  void write(int32_t from, const Color *colors, int32_t count);
+  /// Read the (uncorrected) colors of count LEDs starting at from into colors.
+  void read(int32_t from, Color *colors, int32_t count) const;
+  /// Multiply the colors of all LEDs in [from, to) by scale / 255.
+  void scale(int32_t from, int32_t to, uint8_t scale);
+  /// Read the effect data of count LEDs starting at from into data.
+  void read_effect_data(int32_t from, uint8_t *data, int32_t count) const;
+  /// Set the effect data of count LEDs starting at from.
+  void write_effect_data(int32_t from, const uint8_t *data, int32_t count);
+
   // Indicates whether an effect that directly updates the output buffer is active to prevent overwriting
   bool is_effect_active() const { return this->effect_active_; }
   void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
@@ -96,6 +125,8 @@ class AddressableLight : public LightOutput, public Component {
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// Lights with a contiguous output buffer should return its layout to speed up the bulk operations.
+  virtual PixelBufferLayout get_pixel_buffer_layout_() const { return {}; }
 
   bool effect_active_{false};
   ESPColorCorrection correction_{};
@@ -27,6 +27,9 @@ inline static int16_t sin16_c(uint16_t theta) {
 }
 inline static uint8_t half_sin8(uint8_t v) { return sin16_c(uint16_t(v) * 128u) >> 8; }
 
+/// Number of LEDs the built-in effects compute on the stack before handing them to the bulk AddressableLight methods.
+static const int32_t EFFECT_CHUNK_SIZE = 32;
+
 class AddressableLightEffect : public LightEffect {
  public:
   explicit AddressableLightEffect(const std::string &name) : LightEffect(name) {}
@@ -80,10 +83,15 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
     hsv.saturation = 240;
     uint16_t hue = (millis() * this->speed_) % 0xFFFF;
     const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
+    Color colors[EFFECT_CHUNK_SIZE];
+    for (int32_t start = 0; start < it.size(); start += EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(it.size() - start, EFFECT_CHUNK_SIZE);
+      for (int32_t i = 0; i < count; i++) {
+        hsv.hue = hue >> 8;
+        colors[i] = hsv.to_rgb();
+        hue += add;
+      }
+      it.write(start, colors, count);
     }
     it.schedule_show();
   }
@@ -167,9 +175,7 @@ class AddressableScanEffect : public AddressableLightEffect {
     this->last_move_ = now;
 
     it.all() = Color::BLACK;
-    for (uint32_t i = 0; i < this->scan_width_; i++) {
-      it[this->at_led_ + i] = current_color;
-    }
+    it.fill(this->at_led_, this->at_led_ + this->scan_width_, current_color);
 
     it.schedule_show();
   }
@@ -193,18 +199,24 @@ class AddressableTwinkleEffect : public AddressableLightEffect {
       pos_add = pos_add32;
       this->last_progress_ += pos_add32 * this->progress_interval_;
     }
-    for (auto view : addressable) {
-      if (view.get_effect_data() != 0) {
-        const uint8_t sine = half_sin8(view.get_effect_data());
-        view = current_color * sine;
-        const uint8_t new_pos = view.get_effect_data() + pos_add;
-        if (new_pos < view.get_effect_data())
-          view.set_effect_data(0);
-        else
-          view.set_effect_data(new_pos);
-      } else {
-        view = Color::BLACK;
+    Color colors[EFFECT_CHUNK_SIZE];
+    uint8_t effect_data[EFFECT_CHUNK_SIZE];
+    for (int32_t start = 0; start < addressable.size(); start += EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(addressable.size() - start, EFFECT_CHUNK_SIZE);
+      addressable.read_effect_data(start, effect_data, count);
+      for (int32_t i = 0; i < count; i++) {
+        const uint8_t pos = effect_data[i];
+        if (pos != 0) {
+          const uint8_t sine = half_sin8(pos);
+          colors[i] = current_color * sine;
+          const uint8_t new_pos = pos + pos_add;
+          effect_data[i] = new_pos < pos ? 0 : new_pos;
+        } else {
+          colors[i] = Color::BLACK;
+        }
       }
+      addressable.write(start, colors, count);
+      addressable.write_effect_data(start, effect_data, count);
     }
     while (random_float() < this->twinkle_probability_) {
       const size_t pos = random_uint32() % addressable.size();
@@ -234,24 +246,32 @@ class AddressableRandomTwinkleEffect : public AddressableLightEffect {
       this->last_progress_ = now;
     }
     uint8_t subsine = ((8 * (now - this->last_progress_)) / this->progress_interval_) & 0b111;
-    for (auto view : it) {
-      if (view.get_effect_data() != 0) {
-        const uint8_t x = (view.get_effect_data() >> 3) & 0b11111;
-        const uint8_t color = view.get_effect_data() & 0b111;
-        const uint16_t sine = half_sin8((x << 3) | subsine);
-        if (color == 0) {
-          view = current_color * sine;
+    Color colors[EFFECT_CHUNK_SIZE];
+    uint8_t effect_data[EFFECT_CHUNK_SIZE];
+    for (int32_t start = 0; start < it.size(); start += EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(it.size() - start, EFFECT_CHUNK_SIZE);
+      it.read_effect_data(start, effect_data, count);
+      for (int32_t i = 0; i < count; i++) {
+        if (effect_data[i] != 0) {
+          const uint8_t x = (effect_data[i] >> 3) & 0b11111;
+          const uint8_t color = effect_data[i] & 0b111;
+          const uint16_t sine = half_sin8((x << 3) | subsine);
+          if (color == 0) {
+            colors[i] = current_color * sine;
+          } else {
+            colors[i] = Color(((color >> 2) & 1) * sine, ((color >> 1) & 1) * sine, ((color >> 0) & 1) * sine);
+          }
+          const uint8_t new_x = x + pos_add;
+          if (new_x > 0b11111)
+            effect_data[i] = 0;
+          else
+            effect_data[i] = (new_x << 3) | color;
         } else {
-          view = Color(((color >> 2) & 1) * sine, ((color >> 1) & 1) * sine, ((color >> 0) & 1) * sine);
+          colors[i] = Color(0, 0, 0, 0);
         }
-        const uint8_t new_x = x + pos_add;
-        if (new_x > 0b11111)
-          view.set_effect_data(0);
-        else
-          view.set_effect_data((new_x << 3) | color);
-      } else {
-        view = Color(0, 0, 0, 0);
       }
+      it.write(start, colors, count);
+      it.write_effect_data(start, effect_data, count);
     }
     while (random_float() < this->twinkle_probability_) {
       const size_t pos = random_uint32() % it.size();
@@ -285,18 +305,33 @@ class AddressableFireworksEffect : public AddressableLightEffect {
     this->last_update_ = now;
     // "invert" the fade out parameter so that higher values make fade out faster
     const uint8_t fade_out_mult = 255u - this->fade_out_rate_;
-    for (auto view : it) {
-      Color target = view.get() * fade_out_mult;
-      if (target.r < 64)
-        target *= 170;
-      view = target;
-    }
-    int last = it.size() - 1;
-    it[0].set(it[0].get() + (it[1].get() * 128));
-    for (int i = 1; i < last; i++) {
-      it[i] = (it[i - 1].get() * 64) + it[i].get() + (it[i + 1].get() * 64);
+    const int32_t last = it.size() - 1;
+    // One extra LED is read so the last LED of each chunk can be blurred with its right neighbour
+    Color colors[EFFECT_CHUNK_SIZE + 1];
+    Color prev;
+    for (int32_t start = 0; start <= last; start += EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(last + 1 - start, EFFECT_CHUNK_SIZE);
+      const int32_t read = std::min(last + 1 - start, EFFECT_CHUNK_SIZE + 1);
+      it.read(start, colors, read);
+      for (int32_t i = 0; i < read; i++) {
+        colors[i] *= fade_out_mult;
+        if (colors[i].r < 64)
+          colors[i] *= 170;
+      }
+      // a single LED has nothing to blur with
+      for (int32_t i = 0; i < count && last > 0; i++) {
+        const int32_t index = start + i;
+        if (index == 0) {
+          colors[i] = colors[i] + (colors[i + 1] * 128);
+        } else if (index == last) {
+          colors[i] = colors[i] + (prev * 128);
+        } else {
+          colors[i] = (prev * 64) + colors[i] + (colors[i + 1] * 64);
+        }
+        prev = colors[i];
+      }
+      it.write(start, colors, count);
     }
-    it[last] = it[last].get() + (it[last - 1].get() * 128);
     if (random_float() < this->spark_probability_) {
       const size_t pos = random_uint32() % it.size();
       if (this->use_random_color_) {
@@ -332,13 +367,20 @@ class AddressableFlickerEffect : public AddressableLightEffect {
 
     this->last_update_ = now;
     fast_random_set_seed(random_uint32());
-    for (auto var : it) {
-      const uint8_t flicker = fast_random_8() % intensity;
-      // scale down by random factor
-      var = var.get() * (255 - flicker);
+    const Color target = current_color * intensity;
+    Color colors[EFFECT_CHUNK_SIZE];
+    for (int32_t start = 0; start < it.size(); start += EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(it.size() - start, EFFECT_CHUNK_SIZE);
+      it.read(start, colors, count);
+      for (int32_t i = 0; i < count; i++) {
+        const uint8_t flicker = fast_random_8() % intensity;
+        // scale down by random factor
+        colors[i] *= 255 - flicker;
 
-      // slowly fade back to "real" value
-      var = (var.get() * inv_intensity) + (current_color * intensity);
+        // slowly fade back to "real" value
+        colors[i] = (colors[i] * inv_intensity) + target;
+      }
+      it.write(start, colors, count);
     }
     it.schedule_show();
   }
@@ -8,9 +8,9 @@ namespace light {
 
 // See https://www.home-assistant.io/integrations/light.mqtt/#json-schema for documentation on the schema
 
-void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
+void LightJSONSchema::dump_json(LightState &state, json::JsonWriter &root) {
   if (state.supports_effects())
-    root["effect"] = state.get_effect_name();
+    root.add("effect", state.get_effect_name());
 
   auto values = state.remote_values;
   auto traits = state.get_output()->get_traits();
@@ -19,56 +19,58 @@ void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
     case ColorMode::UNKNOWN:  // don't need to set color mode if we don't know it
       break;
     case ColorMode::ON_OFF:
-      root["color_mode"] = "onoff";
+      root.add("color_mode", "onoff");
       break;
     case ColorMode::BRIGHTNESS:
-      root["color_mode"] = "brightness";
+      root.add("color_mode", "brightness");
       break;
     case ColorMode::WHITE:  // not supported by HA in MQTT
-      root["color_mode"] = "white";
+      root.add("color_mode", "white");
       break;
     case ColorMode::COLOR_TEMPERATURE:
-      root["color_mode"] = "color_temp";
+      root.add("color_mode", "color_temp");
       break;
     case ColorMode::COLD_WARM_WHITE:  // not supported by HA
-      root["color_mode"] = "cwww";
+      root.add("color_mode", "cwww");
       break;
     case ColorMode::RGB:
-      root["color_mode"] = "rgb";
+      root.add("color_mode", "rgb");
       break;
     case ColorMode::RGB_WHITE:
-      root["color_mode"] = "rgbw";
+      root.add("color_mode", "rgbw");
       break;
     case ColorMode::RGB_COLOR_TEMPERATURE:  // not supported by HA
-      root["color_mode"] = "rgbct";
+      root.add("color_mode", "rgbct");
       break;
     case ColorMode::RGB_COLD_WARM_WHITE:
-      root["color_mode"] = "rgbww";
+      root.add("color_mode", "rgbww");
       break;
   }
 
   if (values.get_color_mode() & ColorCapability::ON_OFF)
-    root["state"] = (values.get_state() != 0.0f) ? "ON" : "OFF";
+    root.add("state", (values.get_state() != 0.0f) ? "ON" : "OFF");
   if (values.get_color_mode() & ColorCapability::BRIGHTNESS)
-    root["brightness"] = uint8_t(values.get_brightness() * 255);
+    root.add("brightness", uint8_t(values.get_brightness() * 255));
 
-  JsonObject color = root.createNestedObject("color");
+  root.begin_object("color");
   if (values.get_color_mode() & ColorCapability::RGB) {
-    color["r"] = uint8_t(values.get_color_brightness() * values.get_red() * 255);
-    color["g"] = uint8_t(values.get_color_brightness() * values.get_green() * 255);
-    color["b"] = uint8_t(values.get_color_brightness() * values.get_blue() * 255);
+    root.add("r", uint8_t(values.get_color_brightness() * values.get_red() * 255));
+    root.add("g", uint8_t(values.get_color_brightness() * values.get_green() * 255));
+    root.add("b", uint8_t(values.get_color_brightness() * values.get_blue() * 255));
   }
-  if (values.get_color_mode() & ColorCapability::WHITE) {
-    color["w"] = uint8_t(values.get_white() * 255);
-    root["white_value"] = uint8_t(values.get_white() * 255);  // legacy API
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    root.add("w", uint8_t(values.get_white() * 255));
+  if (values.get_color_mode() & ColorCapability::COLD_WARM_WHITE) {
+    root.add("c", uint8_t(values.get_cold_white() * 255));
+    root.add("w", uint8_t(values.get_warm_white() * 255));
   }
+  root.end_object();
+
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    root.add("white_value", uint8_t(values.get_white() * 255));  // legacy API
   if (values.get_color_mode() & ColorCapability::COLOR_TEMPERATURE) {
     // this one isn't under the color subkey for some reason
-    root["color_temp"] = uint32_t(values.get_color_temperature());
-  }
-  if (values.get_color_mode() & ColorCapability::COLD_WARM_WHITE) {
-    color["c"] = uint8_t(values.get_cold_white() * 255);
-    color["w"] = uint8_t(values.get_warm_white() * 255);
+    root.add("color_temp", uint32_t(values.get_color_temperature()));
   }
 }
 
@@ -13,8 +13,8 @@ namespace light {
 
 class LightJSONSchema {
  public:
-  /// Dump the state of a light as JSON.
-  static void dump_json(LightState &state, JsonObject root);
+  /// Dump the state of a light as JSON, into an object that's being written.
+  static void dump_json(LightState &state, json::JsonWriter &root);
   /// Parse the JSON state of a light to a LightCall.
   static void parse_json(LightState &state, LightCall &call, JsonObject root);
 
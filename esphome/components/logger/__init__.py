@@ -106,12 +106,16 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_DEFERRED_BUFFER_SIZE = "deferred_buffer_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(Logger),
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
+            cv.Optional(CONF_DEFERRED_BUFFER_SIZE): cv.All(
+                cv.validate_bytes, cv.int_range(min=256, max=65536)
+            ),
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
             cv.Optional(CONF_HARDWARE_UART, default="UART0"): uart_selection,
             cv.Optional(CONF_LEVEL, default="DEBUG"): is_log_level,
@@ -144,6 +148,9 @@ async def to_code(config):
         HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]],
     )
     log = cg.Pvariable(config[CONF_ID], rhs)
+    if CONF_DEFERRED_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_DEFERRED")
+        cg.add(log.set_deferred_buffer_size(config[CONF_DEFERRED_BUFFER_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -153,6 +160,15 @@ async def to_code(config):
     cg.add_define("USE_LOGGER")
     this_severity = LOG_LEVEL_SEVERITY.index(level)
     cg.add_build_flag(f"-DESPHOME_LOG_LEVEL={LOG_LEVELS[level]}")
+    if config[CONF_LOGS]:
+        # Per-tag levels can only be less verbose, so messages up to the least
+        # verbose of them don't need a per-tag lookup
+        unfiltered = min(
+            LOG_LEVEL_SEVERITY.index(tag_level)
+            for tag_level in config[CONF_LOGS].values()
+        )
+        unfiltered_level = LOG_LEVELS[LOG_LEVEL_SEVERITY[unfiltered]]
+        cg.add_build_flag(f"-DESPHOME_LOG_UNFILTERED_LEVEL={unfiltered_level}")
 
     verbose_severity = LOG_LEVEL_SEVERITY.index("VERBOSE")
     very_verbose_severity = LOG_LEVEL_SEVERITY.index("VERY_VERBOSE")
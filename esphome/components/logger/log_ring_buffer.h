@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** Lock-free ring buffer of variable length records for many producers and a single consumer.
+ *
+ * Producers reserve space with a compare-and-swap on the write position, fill the record and commit it. The consumer
+ * only sees a record once it's committed, and records are handed out in the order they were reserved. Records never
+ * wrap around the end of the buffer, the space up to the end is skipped instead.
+ */
+class LogRingBuffer {
+ public:
+  /// Allocate the buffer, size is rounded up to a power of two.
+  void init(size_t size) {
+    size_t capacity = 64;
+    while (capacity < size)
+      capacity <<= 1;
+    this->buffer_.reset(new uint32_t[capacity / sizeof(uint32_t)]);  // NOLINT
+    memset(this->buffer_.get(), 0, capacity);
+    this->capacity_ = capacity;
+  }
+  bool is_initialized() const { return this->buffer_ != nullptr; }
+
+  /// Reserve a record of len bytes, returns nullptr and counts a dropped record if there isn't enough space.
+  uint8_t *reserve(size_t len) {
+    // Every record starts with a header word and is padded to whole words
+    len = (sizeof(uint32_t) + len + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+    if (len > MAX_RECORD_SIZE || len > this->capacity_ / 2) {
+      this->dropped_++;
+      return nullptr;
+    }
+
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    uint32_t padding;
+    do {
+      const uint32_t tail = this->tail_.load(std::memory_order_acquire);
+      const uint32_t offset = head & (this->capacity_ - 1);
+      padding = this->capacity_ - offset < len ? this->capacity_ - offset : 0;
+      if (head + padding + len - tail > this->capacity_) {
+        this->dropped_++;
+        return nullptr;
+      }
+    } while (!this->head_.compare_exchange_weak(head, head + padding + len, std::memory_order_acq_rel,
+                                                std::memory_order_relaxed));
+
+    if (padding != 0)
+      __atomic_store_n(this->header_(head), padding | FLAG_COMMITTED | FLAG_PADDING, __ATOMIC_RELEASE);
+    uint32_t *header = this->header_(head + padding);
+    // Not visible to the consumer until commit() sets the committed flag
+    __atomic_store_n(header, len, __ATOMIC_RELAXED);
+    return reinterpret_cast<uint8_t *>(header + 1);
+  }
+  /// Make a record returned by reserve() available to the consumer.
+  void commit(uint8_t *record) {
+    uint32_t *header = reinterpret_cast<uint32_t *>(record) - 1;
+    __atomic_store_n(header, *header | FLAG_COMMITTED, __ATOMIC_RELEASE);
+  }
+
+  /// The oldest record, nullptr if there is none or it's still being written. Only call from the consumer.
+  const uint8_t *front() {
+    while (true) {
+      const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+      if (tail == this->head_.load(std::memory_order_acquire))
+        return nullptr;
+      const uint32_t header = __atomic_load_n(this->header_(tail), __ATOMIC_ACQUIRE);
+      if (!(header & FLAG_COMMITTED))
+        return nullptr;
+      if (!(header & FLAG_PADDING))
+        return reinterpret_cast<const uint8_t *>(this->header_(tail) + 1);
+      this->pop();
+    }
+  }
+  /// Release the record returned by front(). Only call from the consumer.
+  void pop() {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    uint32_t *header = this->header_(tail);
+    const uint32_t len = *header & LENGTH_MASK;
+    // Free space has to be all zero: a producer publishes its position before writing the header, so until then the
+    // consumer reads whatever is left at that spot, which must not look like a committed record.
+    memset(header, 0, len);
+    this->tail_.store(tail + len, std::memory_order_release);
+  }
+
+  /// Number of records that didn't fit, wraps around.
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+  size_t get_capacity() const { return this->capacity_; }
+
+ protected:
+  static const uint32_t LENGTH_MASK = 0xFFFF;
+  static const uint32_t FLAG_COMMITTED = 1 << 16;
+  static const uint32_t FLAG_PADDING = 1 << 17;
+  static const uint32_t MAX_RECORD_SIZE = LENGTH_MASK;
+
+  uint32_t *header_(uint32_t position) const {
+    return this->buffer_.get() + (position & (this->capacity_ - 1)) / sizeof(uint32_t);
+  }
+
+  std::unique_ptr<uint32_t[]> buffer_;
+  size_t capacity_{0};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
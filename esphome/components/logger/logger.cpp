@@ -11,6 +11,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace logger {
 
@@ -51,6 +53,12 @@ void Logger::write_header_(int level, const char *tag, int line) {
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
   if (level > this->level_for(tag) || recursion_guard_)
     return;
+#ifdef USE_LOGGER_DEFERRED
+  if (this->deferred_active_) {
+    this->defer_vprintf_(level, tag, line, format, args);
+    return;
+  }
+#endif
 
   recursion_guard_ = true;
   this->reset_buffer_();
@@ -82,6 +90,16 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   // length of format string, includes null terminator
   uint32_t offset = this->tx_buffer_at_;
 
+#ifdef USE_LOGGER_DEFERRED
+  if (this->deferred_active_) {
+    // The format string can't be parsed in place, so format the message now and only defer writing it
+    this->vprintf_to_buffer_(this->tx_buffer_, args);
+    this->defer_text_(level, tag, line, this->tx_buffer_ + offset, this->tx_buffer_at_ - offset);
+    recursion_guard_ = false;
+    return;
+  }
+#endif
+
   // now apply vsnprintf
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(this->tx_buffer_, args);
@@ -92,13 +110,26 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 #endif
 
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
+  if (this->log_levels_.empty())
+    return ESPHOME_LOG_LEVEL;
+#ifdef USE_ESP32
+  if (xTaskGetCurrentTaskHandle() != this->main_task_)
+    return this->find_level_(tag);
+#endif
+
+  auto &entry = this->tag_level_cache_[(reinterpret_cast<uintptr_t>(tag) >> 2) % this->tag_level_cache_.size()];
+  if (entry.tag == tag)
+    return entry.level;
+
+  int level = this->find_level_(tag);
+  entry.tag = tag;
+  entry.level = level;
+  return level;
+}
+int Logger::find_level_(const char *tag) const {
+  for (const auto &it : this->log_levels_) {
+    if (it.tag == tag)
       return it.level;
-    }
   }
   return ESPHOME_LOG_LEVEL;
 }
@@ -141,6 +172,9 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size, UARTSelection uart)
 }
 
 void Logger::pre_setup() {
+#ifdef USE_ESP32
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     switch (this->uart_) {
@@ -216,6 +250,10 @@ void Logger::pre_setup() {
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
   this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  this->tag_level_cache_.fill({nullptr, 0});
+  // The configured per-tag levels are all covered by ESPHOME_LOG_UNFILTERED_LEVEL, lower ones need the lookup
+  if (log_level < ESPHOME_LOG_UNFILTERED_LEVEL)
+    esp_log_runtime_overrides_ = true;
 }
 UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
@@ -237,7 +275,379 @@ void Logger::dump_config() {
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
+#ifdef USE_LOGGER_DEFERRED
+  ESP_LOGCONFIG(TAG, "  Deferred Buffer Size: %u bytes", (unsigned) this->deferred_buffer_.get_capacity());
+#endif
+}
+#ifdef USE_LOGGER_DEFERRED
+/// Header of a deferred log record, followed by the copied arguments or the formatted text.
+struct DeferredLogRecord {
+  const char *tag;
+  /// nullptr when the payload is the formatted message.
+  const char *format;
+  uint16_t line;
+  uint8_t level;
+};
+
+enum DeferredArgType : uint8_t {
+  DEFERRED_ARG_NONE,
+  DEFERRED_ARG_INT,
+  DEFERRED_ARG_LONG,
+  DEFERRED_ARG_LONG_LONG,
+  DEFERRED_ARG_DOUBLE,
+  DEFERRED_ARG_POINTER,
+  DEFERRED_ARG_STRING,
+  DEFERRED_ARG_UNSUPPORTED,
+};
+
+/// A conversion specification of a printf format string.
+struct FormatSpec {
+  /// Length including the '%' and the conversion character.
+  uint8_t length;
+  /// Number of '*' width and precision arguments.
+  uint8_t stars;
+  bool precision_star;
+  /// Literal precision, -1 if there is none.
+  int precision;
+  DeferredArgType type;
+};
+
+static const uint8_t MAX_FORMAT_SPEC_LENGTH = 15;
+
+template<typename T> static constexpr DeferredArgType integer_arg_type() {
+  return sizeof(T) <= sizeof(int)    ? DEFERRED_ARG_INT
+         : sizeof(T) <= sizeof(long) ? DEFERRED_ARG_LONG
+                                     : DEFERRED_ARG_LONG_LONG;
+}
+
+/// Parse the conversion specification starting at the '%' that start points to.
+static FormatSpec parse_format_spec(const char *start) {
+  FormatSpec spec{0, 0, false, -1, DEFERRED_ARG_UNSUPPORTED};
+  const char *p = start + 1;
+  while (*p != '\0' && strchr("-+ #0", *p) != nullptr)
+    p++;
+  if (*p == '*') {
+    spec.stars++;
+    p++;
+  } else {
+    while (*p >= '0' && *p <= '9')
+      p++;
+  }
+  if (*p == '.') {
+    p++;
+    if (*p == '*') {
+      spec.stars++;
+      spec.precision_star = true;
+      p++;
+    } else {
+      spec.precision = 0;
+      while (*p >= '0' && *p <= '9')
+        spec.precision = spec.precision * 10 + (*p++ - '0');
+    }
+  }
+
+  DeferredArgType integer = DEFERRED_ARG_INT;
+  bool wide = false;
+  switch (*p) {
+    case 'h':
+      p += p[1] == 'h' ? 2 : 1;
+      break;
+    case 'l':
+      if (p[1] == 'l') {
+        integer = DEFERRED_ARG_LONG_LONG;
+        p += 2;
+      } else {
+        integer = DEFERRED_ARG_LONG;
+        wide = true;
+        p++;
+      }
+      break;
+    case 'z':
+      integer = integer_arg_type<size_t>();
+      p++;
+      break;
+    case 't':
+      integer = integer_arg_type<ptrdiff_t>();
+      p++;
+      break;
+    case 'j':
+      integer = integer_arg_type<intmax_t>();
+      p++;
+      break;
+    case 'L':
+      // long double isn't deferred
+      return spec;
+    default:
+      break;
+  }
+
+  switch (*p) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+      spec.type = integer;
+      break;
+    case 'c':
+      // wint_t and char are both promoted to an int sized argument
+      spec.type = DEFERRED_ARG_INT;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec.type = DEFERRED_ARG_DOUBLE;
+      break;
+    case 's':
+      spec.type = wide ? DEFERRED_ARG_UNSUPPORTED : DEFERRED_ARG_STRING;
+      break;
+    case 'p':
+      spec.type = DEFERRED_ARG_POINTER;
+      break;
+    case '%':
+      spec.type = DEFERRED_ARG_NONE;
+      break;
+    default:
+      // %n, the end of the string or something unknown
+      return spec;
+  }
+  spec.length = p - start + 1;
+  if (spec.length > MAX_FORMAT_SPEC_LENGTH)
+    spec.type = DEFERRED_ARG_UNSUPPORTED;
+  return spec;
+}
+
+/** Copy the arguments of a format string into out, or only measure them if out is nullptr.
+ *
+ * Strings are copied (up to max_string_length characters) since they usually don't outlive the log call, everything
+ * else is copied by value. Returns the number of bytes, or -1 if the format can't be deferred.
+ */
+static int encode_format_args(const char *format, va_list args, uint8_t *out, size_t max_string_length) {
+  size_t size = 0;
+  auto put = [out, &size](const void *data, size_t length) {
+    if (out != nullptr)
+      memcpy(out + size, data, length);
+    size += length;
+  };
+  for (const char *p = format; *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    FormatSpec spec = parse_format_spec(p);
+    if (spec.type == DEFERRED_ARG_UNSUPPORTED)
+      return -1;
+    p += spec.length - 1;
+
+    int precision = spec.precision;
+    for (uint8_t i = 0; i < spec.stars; i++) {
+      int value = va_arg(args, int);
+      put(&value, sizeof(value));
+      if (spec.precision_star && i == spec.stars - 1)
+        precision = value;
+    }
+    switch (spec.type) {
+      case DEFERRED_ARG_INT: {
+        int value = va_arg(args, int);
+        put(&value, sizeof(value));
+        break;
+      }
+      case DEFERRED_ARG_LONG: {
+        long value = va_arg(args, long);
+        put(&value, sizeof(value));
+        break;
+      }
+      case DEFERRED_ARG_LONG_LONG: {
+        long long value = va_arg(args, long long);
+        put(&value, sizeof(value));
+        break;
+      }
+      case DEFERRED_ARG_DOUBLE: {
+        double value = va_arg(args, double);
+        put(&value, sizeof(value));
+        break;
+      }
+      case DEFERRED_ARG_POINTER: {
+        void *value = va_arg(args, void *);
+        put(&value, sizeof(value));
+        break;
+      }
+      case DEFERRED_ARG_STRING: {
+        const char *value = va_arg(args, const char *);
+        if (value == nullptr)
+          value = "(null)";
+        // A precision allows strings that aren't null terminated
+        size_t limit = precision >= 0 ? std::min<size_t>(precision, max_string_length) : max_string_length;
+        size_t length = strnlen(value, limit);
+        put(value, length);
+        put("", 1);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return size;
 }
+
+void Logger::defer_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {
+  va_list measure;
+  va_copy(measure, args);
+  int size = encode_format_args(format, measure, nullptr, this->tx_buffer_size_);
+  va_end(measure);
+
+  if (size < 0) {
+    // Fall back to deferring the formatted message
+    va_copy(measure, args);
+    int length = vsnprintf(nullptr, 0, format, measure);
+    va_end(measure);
+    if (length < 0)
+      return;
+    length = std::min(length, this->tx_buffer_size_);
+    uint8_t *text = this->reserve_deferred_(level, tag, line, nullptr, length + 1);
+    if (text == nullptr)
+      return;
+    vsnprintf(reinterpret_cast<char *>(text), length + 1, format, args);
+    this->deferred_buffer_.commit(text - sizeof(DeferredLogRecord));
+    return;
+  }
+
+  uint8_t *data = this->reserve_deferred_(level, tag, line, format, size);
+  if (data == nullptr)
+    return;
+  encode_format_args(format, args, data, this->tx_buffer_size_);
+  this->deferred_buffer_.commit(data - sizeof(DeferredLogRecord));
+}
+uint8_t *Logger::reserve_deferred_(int level, const char *tag, int line, const char *format, size_t size) {
+  uint8_t *record = this->deferred_buffer_.reserve(sizeof(DeferredLogRecord) + size);
+  if (record == nullptr)
+    return nullptr;
+  DeferredLogRecord header{tag, format, static_cast<uint16_t>(line), static_cast<uint8_t>(level)};
+  memcpy(record, &header, sizeof(header));
+  return record + sizeof(header);
+}
+void Logger::defer_text_(int level, const char *tag, int line, const char *text, size_t length) {
+  uint8_t *data = this->reserve_deferred_(level, tag, line, nullptr, length + 1);
+  if (data == nullptr)
+    return;
+  memcpy(data, text, length);
+  data[length] = '\0';
+  this->deferred_buffer_.commit(data - sizeof(DeferredLogRecord));
+}
+
+void Logger::format_deferred_args_(const char *format, const uint8_t *args) {
+  const char *literal = format;
+  const char *p = format;
+  for (; *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    this->write_to_buffer_(literal, p - literal);
+    FormatSpec spec = parse_format_spec(p);
+    literal = p + spec.length;
+
+    int stars[2];
+    memcpy(stars, args, spec.stars * sizeof(int));
+    args += spec.stars * sizeof(int);
+    char spec_format[MAX_FORMAT_SPEC_LENGTH + 1];
+    memcpy(spec_format, p, spec.length);
+    spec_format[spec.length] = '\0';
+    p = literal - 1;
+
+    switch (spec.type) {
+      case DEFERRED_ARG_INT: {
+        int value;
+        memcpy(&value, args, sizeof(value));
+        args += sizeof(value);
+        this->printf_deferred_arg_(spec_format, stars, spec.stars, value);
+        break;
+      }
+      case DEFERRED_ARG_LONG: {
+        long value;
+        memcpy(&value, args, sizeof(value));
+        args += sizeof(value);
+        this->printf_deferred_arg_(spec_format, stars, spec.stars, value);
+        break;
+      }
+      case DEFERRED_ARG_LONG_LONG: {
+        long long value;
+        memcpy(&value, args, sizeof(value));
+        args += sizeof(value);
+        this->printf_deferred_arg_(spec_format, stars, spec.stars, value);
+        break;
+      }
+      case DEFERRED_ARG_DOUBLE: {
+        double value;
+        memcpy(&value, args, sizeof(value));
+        args += sizeof(value);
+        this->printf_deferred_arg_(spec_format, stars, spec.stars, value);
+        break;
+      }
+      case DEFERRED_ARG_POINTER: {
+        void *value;
+        memcpy(&value, args, sizeof(value));
+        args += sizeof(value);
+        this->printf_deferred_arg_(spec_format, stars, spec.stars, value);
+        break;
+      }
+      case DEFERRED_ARG_STRING: {
+        const char *value = reinterpret_cast<const char *>(args);
+        args += strlen(value) + 1;
+        this->printf_deferred_arg_(spec_format, stars, spec.stars, value);
+        break;
+      }
+      default:
+        this->write_to_buffer_('%');
+        break;
+    }
+  }
+  this->write_to_buffer_(literal, p - literal);
+}
+
+void Logger::process_deferred_() {
+  const uint8_t *data;
+  while ((data = this->deferred_buffer_.front()) != nullptr) {
+    DeferredLogRecord record;
+    memcpy(&record, data, sizeof(record));
+    const uint8_t *payload = data + sizeof(record);
+
+    this->recursion_guard_ = true;
+    this->reset_buffer_();
+    this->write_header_(record.level, record.tag, record.line);
+    if (record.format == nullptr) {
+      const char *text = reinterpret_cast<const char *>(payload);
+      this->write_to_buffer_(text, strlen(text));
+    } else {
+      this->format_deferred_args_(record.format, payload);
+    }
+    this->write_footer_();
+    this->log_message_(record.level, record.tag);
+    this->recursion_guard_ = false;
+    this->deferred_buffer_.pop();
+  }
+
+  const uint32_t dropped = this->deferred_buffer_.get_dropped();
+  if (dropped != this->deferred_dropped_) {
+    const uint32_t count = dropped - this->deferred_dropped_;
+    this->deferred_dropped_ = dropped;
+    ESP_LOGW(TAG, "Dropped %u log messages, consider increasing deferred_buffer_size", count);
+  }
+}
+void Logger::loop() {
+  this->deferred_active_ = true;
+  this->process_deferred_();
+}
+bool Logger::has_pending_loop_work() { return !this->deferred_active_ || this->deferred_buffer_.front() != nullptr; }
+void Logger::on_shutdown() {
+  this->process_deferred_();
+  // Nothing drains the buffer anymore
+  this->deferred_active_ = false;
+}
+#endif
+
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
 Logger *global_logger = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -4,14 +4,23 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
+#include <array>
 #include <cstdarg>
 
+#ifdef USE_LOGGER_DEFERRED
+#include "log_ring_buffer.h"
+#endif
+
 #ifdef USE_ARDUINO
 #include <HardwareSerial.h>
 #endif
 #ifdef USE_ESP_IDF
 #include <driver/uart.h>
 #endif
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 
 namespace esphome {
 
@@ -49,9 +58,22 @@ class Logger : public Component {
   /// Get the UART used by the logger.
   UARTSelection get_uart() const;
 
-  /// Set the log level of the specified tag.
+  /// Set the log level of the specified tag. Must be called from the main task.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_DEFERRED
+  /** Only record log messages into a ring buffer of the given size at the call site, and format and write them from
+   * loop().
+   *
+   * Records store the format string and tag pointers, so both must outlive the record. Messages that don't fit are
+   * dropped and counted.
+   */
+  void set_deferred_buffer_size(size_t size) { this->deferred_buffer_.init(size); }
+  void loop() override;
+  bool has_pending_loop_work() override;
+  void on_shutdown() override;
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -74,6 +96,30 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  /// Look up the configured level of a tag without the cache.
+  int find_level_(const char *tag) const;
+
+#ifdef USE_LOGGER_DEFERRED
+  void defer_vprintf_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Reserve a record for a message, a nullptr format marks the payload as already formatted text.
+  uint8_t *reserve_deferred_(int level, const char *tag, int line, const char *format, size_t size);
+  void defer_text_(int level, const char *tag, int line, const char *text, size_t length);
+  void process_deferred_();
+  void format_deferred_args_(const char *format, const uint8_t *args);
+  template<typename T> void printf_deferred_arg_(const char *spec, const int *stars, uint8_t star_count, T value) {
+    switch (star_count) {
+      case 0:
+        this->printf_to_buffer_(spec, value);
+        break;
+      case 1:
+        this->printf_to_buffer_(spec, stars[0], value);
+        break;
+      default:
+        this->printf_to_buffer_(spec, stars[0], stars[1], value);
+        break;
+    }
+  }
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -129,9 +175,27 @@ class Logger : public Component {
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
+  struct TagLevelCacheEntry {
+    const char *tag;
+    int level;
+  };
+  /// Resolved levels by tag pointer, since tags are almost always a static TAG constant. Only used from the main task,
+  /// other tasks could read half-written entries.
+  std::array<TagLevelCacheEntry, 16> tag_level_cache_{};
+#ifdef USE_ESP32
+  /// Task that set up the logger.
+  TaskHandle_t main_task_{nullptr};
+#endif
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_DEFERRED
+  LogRingBuffer deferred_buffer_;
+  /// Dropped record count that was last reported.
+  uint32_t deferred_dropped_{0};
+  /// Messages are written synchronously until the first loop(), so that nothing logged during setup gets dropped.
+  bool deferred_active_{false};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -60,7 +60,14 @@ template<typename T> class ApplianceBase : public Component {
     this->base_.addOnStateCallback(std::bind(&ApplianceBase::on_status_change, this));
     dudanov::midea::ApplianceBase::setLogger(
         [](int level, const char *tag, int line, const String &format, va_list args) {
+#ifdef USE_LOGGER_DEFERRED
+          // The format string doesn't outlive this call, so it can't be deferred
+          char message[256];
+          vsnprintf(message, sizeof(message), format.c_str(), args);
+          esp_log_printf_(level, tag, line, "%s", message);
+#else
           esp_log_vprintf_(level, tag, line, format.c_str(), args);
+#endif
         });
   }
 
@@ -1,107 +1,181 @@
 #include "modbus.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include <algorithm>
 
 namespace esphome {
 namespace modbus {
 
 static const char *const TAG = "modbus";
+/// Minimum time in µs without new bytes before an incomplete frame is dropped, a bit more than one loop interval.
+static const uint32_t MIN_INCOMPLETE_FRAME_TIMEOUT = 20000;
 
 void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+
+  // start bit, data bits, optional parity bit and stop bits
+  uint32_t bits = 1 + this->parent_->get_data_bits() + this->parent_->get_stop_bits();
+  if (this->parent_->get_parity() != uart::UART_CONFIG_PARITY_NONE)
+    bits++;
+  const uint32_t baud_rate = this->parent_->get_baud_rate();
+  this->char_time_ = (bits * 1000000 + baud_rate - 1) / baud_rate;
+  // Frames are separated by at least 3.5 characters of silence, above 19200 baud the spec fixes this at 1750µs
+  this->frame_gap_ = baud_rate > 19200 ? 1750 : (this->char_time_ * 7 + 1) / 2;
+
+  this->utilization_since_ = micros();
+  this->set_interval("stats", 60000, [this]() { this->log_stats_(); });
 }
-void Modbus::loop() {
-  const uint32_t now = millis();
 
-  if (now - this->last_modbus_byte_ > 50) {
-    this->rx_buffer_.clear();
-    this->last_modbus_byte_ = now;
-  }
+void Modbus::loop() {
   // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
-  if (now - this->last_send_ > send_wait_time_) {
+  if (millis() - this->last_send_ > send_wait_time_) {
+    if (this->request_active_ && waiting_for_response != 0)
+      this->end_request_(true);
     waiting_for_response = 0;
   }
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
+  this->receive_();
+
+  // Only start a new command once the previous one is done and nobody else is talking
+  if (waiting_for_response == 0 && this->rx_size_ == 0)
+    this->send_next_request_();
+}
+
+void Modbus::receive_() {
+  const uint32_t now = micros();
+  int available = this->available();
+  if (available <= 0) {
+    if (this->rx_size_ != 0) {
+      // The rest of the frame should have arrived by now, followed by the inter-frame silence. The remaining
+      // transmission time is included because the UART driver might hand us the received bytes in chunks. Bytes are
+      // only noticed once per loop, so a frame split over two loop iterations mustn't be dropped either.
+      const uint32_t remaining = (this->frame_size_() - this->rx_size_) * this->char_time_ + this->frame_gap_;
+      const uint32_t timeout = std::max(remaining, MIN_INCOMPLETE_FRAME_TIMEOUT);
+      if (now - this->last_rx_ > timeout) {
+        ESP_LOGW(TAG, "Dropping incomplete Modbus frame: %s",
+                 format_hex_pretty(this->rx_buffer_, this->rx_size_).c_str());
+        this->reset_frame_();
+      }
+    }
+    return;
+  }
+
+  this->last_rx_ = now;
+  while (available > 0) {
+    // Only read up to the end of the current frame, the header tells how long it is.
+    const uint16_t len = std::min<uint16_t>(this->frame_size_() - this->rx_size_, available);
+    uint8_t *data = this->rx_buffer_ + this->rx_size_;
+    if (!this->read_array(data, len)) {
+      this->reset_frame_();
+      break;
+    }
+    this->rx_crc_ = crc16(data, len, this->rx_crc_);
+    this->rx_size_ += len;
+    available -= len;
+
+    if (this->rx_size_ < 3 || this->rx_size_ != this->frame_size_())
+      continue;
+
+    ESP_LOGV(TAG, "Modbus received frame: %s", format_hex_pretty(this->rx_buffer_, this->rx_size_).c_str());
+    if (this->rx_crc_ == 0) {
+      this->handle_frame_();
     } else {
-      this->rx_buffer_.clear();
+      const uint16_t computed_crc = crc16(this->rx_buffer_, this->rx_size_ - 2);
+      const uint16_t remote_crc =
+          uint16_t(this->rx_buffer_[this->rx_size_ - 2]) | (uint16_t(this->rx_buffer_[this->rx_size_ - 1]) << 8);
+      ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
     }
+    this->reset_frame_();
   }
 }
 
-uint16_t crc16(const uint8_t *data, uint8_t len) {
-  uint16_t crc = 0xFFFF;
+// Modbus CRC (polynomial 0xA001, reflected) lookup tables, split into low and high byte so they can live in flash.
+static const uint8_t CRC16_TABLE_LO[256] PROGMEM = {
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+};
+static const uint8_t CRC16_TABLE_HI[256] PROGMEM = {
+    0x00, 0xC0, 0xC1, 0x01, 0xC3, 0x03, 0x02, 0xC2, 0xC6, 0x06, 0x07, 0xC7, 0x05, 0xC5, 0xC4, 0x04,
+    0xCC, 0x0C, 0x0D, 0xCD, 0x0F, 0xCF, 0xCE, 0x0E, 0x0A, 0xCA, 0xCB, 0x0B, 0xC9, 0x09, 0x08, 0xC8,
+    0xD8, 0x18, 0x19, 0xD9, 0x1B, 0xDB, 0xDA, 0x1A, 0x1E, 0xDE, 0xDF, 0x1F, 0xDD, 0x1D, 0x1C, 0xDC,
+    0x14, 0xD4, 0xD5, 0x15, 0xD7, 0x17, 0x16, 0xD6, 0xD2, 0x12, 0x13, 0xD3, 0x11, 0xD1, 0xD0, 0x10,
+    0xF0, 0x30, 0x31, 0xF1, 0x33, 0xF3, 0xF2, 0x32, 0x36, 0xF6, 0xF7, 0x37, 0xF5, 0x35, 0x34, 0xF4,
+    0x3C, 0xFC, 0xFD, 0x3D, 0xFF, 0x3F, 0x3E, 0xFE, 0xFA, 0x3A, 0x3B, 0xFB, 0x39, 0xF9, 0xF8, 0x38,
+    0x28, 0xE8, 0xE9, 0x29, 0xEB, 0x2B, 0x2A, 0xEA, 0xEE, 0x2E, 0x2F, 0xEF, 0x2D, 0xED, 0xEC, 0x2C,
+    0xE4, 0x24, 0x25, 0xE5, 0x27, 0xE7, 0xE6, 0x26, 0x22, 0xE2, 0xE3, 0x23, 0xE1, 0x21, 0x20, 0xE0,
+    0xA0, 0x60, 0x61, 0xA1, 0x63, 0xA3, 0xA2, 0x62, 0x66, 0xA6, 0xA7, 0x67, 0xA5, 0x65, 0x64, 0xA4,
+    0x6C, 0xAC, 0xAD, 0x6D, 0xAF, 0x6F, 0x6E, 0xAE, 0xAA, 0x6A, 0x6B, 0xAB, 0x69, 0xA9, 0xA8, 0x68,
+    0x78, 0xB8, 0xB9, 0x79, 0xBB, 0x7B, 0x7A, 0xBA, 0xBE, 0x7E, 0x7F, 0xBF, 0x7D, 0xBD, 0xBC, 0x7C,
+    0xB4, 0x74, 0x75, 0xB5, 0x77, 0xB7, 0xB6, 0x76, 0x72, 0xB2, 0xB3, 0x73, 0xB1, 0x71, 0x70, 0xB0,
+    0x50, 0x90, 0x91, 0x51, 0x93, 0x53, 0x52, 0x92, 0x96, 0x56, 0x57, 0x97, 0x55, 0x95, 0x94, 0x54,
+    0x9C, 0x5C, 0x5D, 0x9D, 0x5F, 0x9F, 0x9E, 0x5E, 0x5A, 0x9A, 0x9B, 0x5B, 0x99, 0x59, 0x58, 0x98,
+    0x88, 0x48, 0x49, 0x89, 0x4B, 0x8B, 0x8A, 0x4A, 0x4E, 0x8E, 0x8F, 0x4F, 0x8D, 0x4D, 0x4C, 0x8C,
+    0x44, 0x84, 0x85, 0x45, 0x87, 0x47, 0x46, 0x86, 0x82, 0x42, 0x43, 0x83, 0x41, 0x81, 0x80, 0x40,
+};
+
+uint16_t crc16(const uint8_t *data, uint16_t len, uint16_t crc) {
   while (len--) {
-    crc ^= *data++;
-    for (uint8_t i = 0; i < 8; i++) {
-      if ((crc & 0x01) != 0) {
-        crc >>= 1;
-        crc ^= 0xA001;
-      } else {
-        crc >>= 1;
-      }
-    }
+    const uint8_t index = (crc ^ *data++) & 0xFF;
+    crc = ((crc >> 8) ^ progmem_read_byte(&CRC16_TABLE_LO[index])) |
+          (uint16_t(progmem_read_byte(&CRC16_TABLE_HI[index])) << 8);
   }
   return crc;
 }
 
-bool Modbus::parse_modbus_byte_(uint8_t byte) {
-  size_t at = this->rx_buffer_.size();
-  this->rx_buffer_.push_back(byte);
-  const uint8_t *raw = &this->rx_buffer_[0];
-  ESP_LOGV(TAG, "Modbus received Byte  %d (0X%x)", byte, byte);
-  // Byte 0: modbus address (match all)
-  if (at == 0)
-    return true;
-  uint8_t address = raw[0];
-  uint8_t function_code = raw[1];
-  // Byte 2: Size (with modbus rtu function code 4/3)
+uint16_t Modbus::frame_size_() const {
+  // Byte 0: modbus address (match all), byte 1: function code, byte 2: size (with modbus rtu function code 4/3)
   // See also https://en.wikipedia.org/wiki/Modbus
-  if (at == 2)
-    return true;
-
-  uint8_t data_len = raw[2];
-  uint8_t data_offset = 3;
-  // the response for write command mirrors the requests and data startes at offset 2 instead of 3 for read commands
-  if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10) {
-    data_offset = 2;
-    data_len = 4;
-  }
+  if (this->rx_size_ < 3)
+    return 3;
 
+  const uint8_t function_code = this->rx_buffer_[1];
   // Error ( msb indicates error )
   // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] excpetion code, Byte[3-4] crc
-  if ((function_code & 0x80) == 0x80) {
-    data_offset = 2;
-    data_len = 1;
-  }
+  if ((function_code & 0x80) == 0x80)
+    return 5;
+  // the response for write command mirrors the requests: address, function code, 4 data bytes and crc
+  if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10)
+    return 8;
+  // address, function code, byte count, data and crc
+  return 3 + this->rx_buffer_[2] + 2;
+}
 
-  // Byte data_offset..data_offset+data_len-1: Data
-  if (at < data_offset + data_len)
-    return true;
+void Modbus::reset_frame_() {
+  this->rx_size_ = 0;
+  this->rx_crc_ = 0xFFFF;
+}
 
-  // Byte 3+data_len: CRC_LO (over all bytes)
-  if (at == data_offset + data_len)
-    return true;
+void Modbus::handle_frame_() {
+  const uint8_t *raw = this->rx_buffer_;
+  const uint8_t address = raw[0];
+  const uint8_t function_code = raw[1];
+  const bool is_error = (function_code & 0x80) == 0x80;
+
+  // the response for write command mirrors the requests and data startes at offset 2 instead of 3 for read commands
+  const uint8_t data_offset = (is_error || this->frame_size_() == 8) ? 2 : 3;
+  this->frame_data_.assign(raw + data_offset, raw + this->rx_size_ - 2);
 
-  // Byte data_offset+len+1: CRC_HI (over all bytes)
-  uint16_t computed_crc = crc16(raw, data_offset + data_len);
-  uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-  if (computed_crc != remote_crc) {
-    ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
-    return false;
-  }
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
   bool found = false;
   for (auto *device : this->devices_) {
     if (device->address_ == address) {
       // Is it an error response?
-      if ((function_code & 0x80) == 0x80) {
+      if (is_error) {
         ESP_LOGD(TAG, "Modbus error function code: 0x%X exception: %d", function_code, raw[2]);
         if (waiting_for_response != 0) {
           device->on_modbus_error(function_code & 0x7F, raw[2]);
@@ -110,25 +184,104 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
           ESP_LOGD(TAG, "Ignoring Modbus error - not expecting a response");
         }
       } else {
-        device->on_modbus_data(data);
+        device->on_modbus_data(this->frame_data_);
       }
       found = true;
     }
   }
+  // a response from another device means the one we were waiting for isn't going to answer anymore
+  if (this->request_active_)
+    this->end_request_(waiting_for_response != address);
   waiting_for_response = 0;
 
   if (!found) {
     ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X! ", address);
   }
+}
+
+void Modbus::send_next_request_() {
+  ModbusDevice *next = nullptr;
+  PendingRequest best{};
+  for (auto *device : this->devices_) {
+    auto request = device->next_request();
+    if (!request.has_value())
+      continue;
+    // urgent first, then the earliest deadline (compared so that it works across millis() overflows)
+    if (next == nullptr || (request->urgent && !best.urgent) ||
+        (request->urgent == best.urgent && int32_t(request->deadline - best.deadline) < 0)) {
+      next = device;
+      best = *request;
+    }
+  }
+  if (next != nullptr)
+    next->send_request();
+}
 
-  // return false to reset buffer
-  return false;
+void Modbus::start_request_(uint8_t address) {
+  const uint32_t now = micros();
+  if (this->request_active_)
+    this->busy_time_ += now - this->busy_since_;
+  this->busy_since_ = now;
+  this->request_active_ = true;
+  this->requests_++;
+  waiting_for_response = address;
+  last_send_ = millis();
+}
+
+void Modbus::end_request_(bool timeout) {
+  this->request_active_ = false;
+  this->busy_time_ += micros() - this->busy_since_;
+  if (timeout)
+    this->timeouts_++;
+
+  const uint32_t response_time = millis() - this->last_send_;
+  for (auto *device : this->devices_) {
+    if (device->address_ != waiting_for_response)
+      continue;
+    if (timeout) {
+      ESP_LOGV(TAG, "No response from device 0x%02X within %u ms", device->address_, this->send_wait_time_);
+      device->timeouts_++;
+    } else {
+      // exponential moving average, so the value follows changes in the device's response time
+      device->response_time_ =
+          device->responses_ == 0 ? response_time : (device->response_time_ * 7 + response_time + 4) / 8;
+      device->responses_++;
+    }
+  }
+}
+
+float Modbus::get_utilization() const {
+  const uint32_t now = micros();
+  uint32_t busy = this->busy_time_;
+  if (this->request_active_)
+    busy += now - this->busy_since_;
+  const uint32_t elapsed = now - this->utilization_since_;
+  return elapsed == 0 ? 0.0f : float(busy) / float(elapsed);
+}
+void Modbus::reset_utilization_() {
+  const uint32_t now = micros();
+  // The running command only counts from here on
+  if (this->request_active_)
+    this->busy_since_ = now;
+  this->busy_time_ = 0;
+  this->utilization_since_ = now;
+}
+
+void Modbus::log_stats_() {
+  ESP_LOGD(TAG, "Bus utilization: %.1f%%, %u commands sent, %u timeouts", this->get_utilization() * 100.0f,
+           this->requests_, this->timeouts_);
+  this->reset_utilization_();
+  for (auto *device : this->devices_) {
+    ESP_LOGV(TAG, "  Device 0x%02X: response time %u ms, %u timeouts", device->address_, device->response_time_,
+             device->timeouts_);
+  }
 }
 
 void Modbus::dump_config() {
   ESP_LOGCONFIG(TAG, "Modbus:");
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
+  ESP_LOGCONFIG(TAG, "  Frame Gap: %u us", this->frame_gap_);
 }
 float Modbus::get_setup_priority() const {
   // After UART bus
@@ -179,8 +332,7 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
 
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = address;
-  last_send_ = millis();
+  this->start_request_(address);
   ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
 }
 
@@ -201,9 +353,8 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
   this->flush();
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = payload[0];
+  this->start_request_(payload[0]);
   ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
-  last_send_ = millis();
 }
 
 }  // namespace modbus
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/optional.h"
 #include "esphome/components/uart/uart.h"
 
 namespace esphome {
@@ -8,6 +9,14 @@ namespace modbus {
 
 class ModbusDevice;
 
+/// A command a device wants to send, used by Modbus to decide which device gets the bus next.
+struct PendingRequest {
+  /// millis() timestamp by which the command should have been sent
+  uint32_t deadline;
+  /// urgent commands (writes) are sent before all others
+  bool urgent;
+};
+
 class Modbus : public uart::UARTDevice, public Component {
  public:
   Modbus() = default;
@@ -29,18 +38,64 @@ class Modbus : public uart::UARTDevice, public Component {
   uint8_t waiting_for_response{0};
   void set_send_wait_time(uint16_t time_in_ms) { send_wait_time_ = time_in_ms; }
 
+  /// Number of commands sent since boot.
+  uint32_t get_requests() const { return this->requests_; }
+  /// Number of commands that didn't get a response within the send wait time.
+  uint32_t get_timeouts() const { return this->timeouts_; }
+  /// Fraction of the time the bus was in use (sending a command or waiting for its response) since the statistics
+  /// were last logged.
+  float get_utilization() const;
+
  protected:
   GPIOPin *flow_control_pin_{nullptr};
 
-  bool parse_modbus_byte_(uint8_t byte);
+  /// Give the bus to the device with the most urgent pending command.
+  void send_next_request_();
+  /// Start waiting for the response of a command that was just sent.
+  void start_request_(uint8_t address);
+  /// Stop waiting for the response of the current command, either because it arrived or because of a timeout.
+  void end_request_(bool timeout);
+  /// Start a new utilization measurement.
+  void reset_utilization_();
+  void log_stats_();
+
+  /// Read the available bytes and handle the frames they complete.
+  void receive_();
+  /// Size of the frame in rx_buffer_, as far as known from the bytes received so far.
+  uint16_t frame_size_() const;
+  void reset_frame_();
+  void handle_frame_();
+
+  /// Longest RTU frame: address, function code, byte count, 255 data bytes and the CRC.
+  static const uint16_t MAX_FRAME_SIZE = 260;
+
   uint16_t send_wait_time_{250};
-  std::vector<uint8_t> rx_buffer_;
-  uint32_t last_modbus_byte_{0};
+  uint8_t rx_buffer_[MAX_FRAME_SIZE];
+  uint16_t rx_size_{0};
+  /// CRC over the received bytes, including the CRC of the frame itself (so it's 0 for a valid frame).
+  uint16_t rx_crc_{0xFFFF};
+  /// Payload passed to the devices, kept around so that its memory is reused between frames.
+  std::vector<uint8_t> frame_data_;
+  uint32_t last_rx_{0};
+  /// Time it takes to transmit a single character in µs.
+  uint32_t char_time_{0};
+  /// Silence between two frames in µs (3.5 characters).
+  uint32_t frame_gap_{0};
   uint32_t last_send_{0};
   std::vector<ModbusDevice *> devices_;
+
+  uint32_t requests_{0};
+  uint32_t timeouts_{0};
+  /// Whether waiting_for_response was set by this instance, and when (in µs) the bus was last reserved.
+  bool request_active_{false};
+  uint32_t busy_since_{0};
+  /// Time the bus was in use since the last utilization measurement, in µs.
+  uint32_t busy_time_{0};
+  uint32_t utilization_since_{0};
 };
 
-uint16_t crc16(const uint8_t *data, uint8_t len);
+/// Calculate the Modbus CRC of data, or continue calculating it from a previous crc.
+uint16_t crc16(const uint8_t *data, uint16_t len, uint16_t crc = 0xFFFF);
 
 class ModbusDevice {
  public:
@@ -56,11 +111,24 @@ class ModbusDevice {
   // If more than one device is connected block sending a new command before a response is received
   bool waiting_for_response() { return parent_->waiting_for_response != 0; }
 
+  /// The command this device wants to send next, if any. Devices sending commands on their own don't need this.
+  virtual optional<PendingRequest> next_request() { return {}; }
+  /// Called by the bus when the command returned by next_request() may be sent.
+  virtual void send_request() {}
+
+  /// Smoothed time between sending a command and receiving the response from this device, in ms.
+  uint32_t get_response_time() const { return this->response_time_; }
+  /// Number of commands to this device that didn't get a response.
+  uint32_t get_timeouts() const { return this->timeouts_; }
+
  protected:
   friend Modbus;
 
   Modbus *parent_;
   uint8_t address_;
+  uint32_t response_time_{0};
+  uint32_t responses_{0};
+  uint32_t timeouts_{0};
 };
 
 }  // namespace modbus
@@ -7,6 +7,10 @@ namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
 
+/// Most registers or bits a single read command may request
+static const uint16_t MAX_READ_REGISTERS = 125;
+static const uint16_t MAX_READ_BITS = 2000;
+
 void ModbusController::setup() {
   // Modbus::setup();
   this->create_register_ranges_();
@@ -16,8 +20,18 @@ void ModbusController::setup() {
  To work with the existing modbus class and avoid polling for responses a command queue is used.
  send_next_command will submit the command at the top of the queue and set the corresponding callback
  to handle the response from the device.
- Once the response has been processed it is removed from the queue and the next command is sent
+ Once the response has been processed it is removed from the queue and the next command is sent.
+ When the bus is free it asks all controllers for the command at the top of their queue (see next_request) and lets
+ the one with the most urgent command send it, so controllers sharing a bus are served by deadline instead of in
+ loop order.
 */
+optional<modbus::PendingRequest> ModbusController::next_request() {
+  if (this->command_queue_.empty() || millis() - this->last_command_timestamp_ <= this->command_throttle_)
+    return {};
+  auto &command = this->command_queue_.front();
+  return modbus::PendingRequest{command->deadline, command->is_write()};
+}
+
 bool ModbusController::send_next_command_() {
   uint32_t last_send = millis() - this->last_command_timestamp_;
 
@@ -105,7 +119,7 @@ void ModbusController::on_register_data(ModbusRegisterType register_type, uint16
   }
 }
 
-void ModbusController::queue_command(const ModbusCommandItem &command) {
+void ModbusController::queue_command(ModbusCommandItem command) {
   // check if this commmand is already qeued.
   // not very effective but the queue is never really large
   for (auto &item : command_queue_) {
@@ -118,7 +132,24 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
       return;
     }
   }
-  command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+
+  // Reads should be done before the next update, writes as soon as possible
+  const uint32_t update_interval = this->get_update_interval();
+  command.deadline = millis();
+  if (!command.is_write() && update_interval != SCHEDULER_DONT_RUN)
+    command.deadline += update_interval;
+
+  auto it = command_queue_.begin();
+  if (command.is_write()) {
+    // keep the command that has already been sent at the top, it's waiting for its response
+    if (it != command_queue_.end() && (*it)->send_countdown != ModbusCommandItem::MAX_SEND_REPEATS)
+      it++;
+    while (it != command_queue_.end() && (*it)->is_write())
+      it++;
+  } else {
+    it = command_queue_.end();
+  }
+  command_queue_.insert(it, make_unique<ModbusCommandItem>(std::move(command)));
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -137,7 +168,7 @@ void ModbusController::update_range_(RegisterRange &r) {
         command_item.register_address = it->second->start_address;
         command_item.register_count = it->second->register_count;
         command_item.function_code = ModbusFunctionCode::CUSTOM;
-        queue_command(command_item);
+        queue_command(std::move(command_item));
       }
     } else {
       queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
@@ -186,7 +217,13 @@ size_t ModbusController::create_register_ranges_() {
              buffer_offset, ix->second->skip_updates);
     // if this is a sequential address based on number of registers and address of previous sensor
     // convert to an offset to the previous sensor (address 0x101 becomes address 0x100 offset 2 bytes)
+    // but don't let a range grow beyond what a single read command can return
+    const uint16_t max_registers = (ix->second->register_type == ModbusRegisterType::COIL ||
+                                    ix->second->register_type == ModbusRegisterType::DISCRETE_INPUT)
+                                       ? MAX_READ_BITS
+                                       : MAX_READ_REGISTERS;
     if (!ix->second->force_new_range && total_register_count >= 0 &&
+        total_register_count + ix->second->register_count <= max_registers &&
         prev->second->register_type == ix->second->register_type &&
         prev->second->start_address + total_register_count == ix->second->start_address &&
         prev->second->start_address < ix->second->start_address) {
@@ -276,16 +313,12 @@ void ModbusController::dump_config() {
 }
 
 void ModbusController::loop() {
-  // Incoming data to process?
+  // Incoming data to process? Pending commands are sent when the bus asks for them.
   if (!incoming_queue_.empty()) {
     auto &message = incoming_queue_.front();
     if (message != nullptr)
       process_modbus_data_(message.get());
     incoming_queue_.pop();
-
-  } else {
-    // all messages processed send pending commmands
-    send_next_command_();
   }
 }
 
@@ -283,7 +283,16 @@ class ModbusCommandItem {
   std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
       on_data_func;
   std::vector<uint8_t> payload = {};
+  /// millis() timestamp by which the command should have been sent, set when it's queued
+  uint32_t deadline{0};
   bool send();
+  /// Whether this command writes to the device, these are sent before read commands
+  bool is_write() const {
+    return this->function_code == ModbusFunctionCode::WRITE_SINGLE_COIL ||
+           this->function_code == ModbusFunctionCode::WRITE_SINGLE_REGISTER ||
+           this->function_code == ModbusFunctionCode::WRITE_MULTIPLE_COILS ||
+           this->function_code == ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS;
+  }
   // wrong commands (esp. custom commands) can block the send queue
   // limit the number of repeats
   uint8_t send_countdown{MAX_SEND_REPEATS};
@@ -379,14 +388,18 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void setup() override;
   void update() override;
 
-  /// queues a modbus command in the send queue
-  void queue_command(const ModbusCommandItem &command);
+  /// queues a modbus command in the send queue, writes go before reads
+  void queue_command(ModbusCommandItem command);
   /// Registers a sensor with the controller. Called by esphomes code generator
   void add_sensor_item(SensorItem *item) { sensormap_[item->getkey()] = item; }
   /// called when a modbus response was prased without errors
   void on_modbus_data(const std::vector<uint8_t> &data) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
+  /// the command at the top of the send queue, the bus decides which controller sends next
+  optional<modbus::PendingRequest> next_request() override;
+  /// called by the bus when this controller may send its next command
+  void send_request() override { this->send_next_command_(); }
   /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
   void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data);
   /// default delegate called by process_modbus_data when a response for a write response has retrieved from the
@@ -69,7 +69,7 @@ void ModbusNumber::control(float value) {
     parent_->on_write_register_response(write_cmd.register_type, start_address, data);
     this->publish_state(value);
   };
-  parent_->queue_command(write_cmd);
+  parent_->queue_command(std::move(write_cmd));
 }
 void ModbusNumber::dump_config() { LOG_NUMBER(TAG, "Modbus Number", this); }
 
@@ -46,7 +46,7 @@ void ModbusFloatOutput::write_state(float value) {
     write_cmd = ModbusCommandItem::create_write_multiple_command(parent_, this->start_address + this->offset,
                                                                  this->register_count, data);
   }
-  parent_->queue_command(write_cmd);
+  parent_->queue_command(std::move(write_cmd));
 }
 
 void ModbusFloatOutput::dump_config() {
@@ -96,7 +96,7 @@ void ModbusBinaryOutput::write_state(bool state) {
       cmd = ModbusCommandItem::create_write_single_coil(parent_, this->start_address + this->offset, state);
     }
   }
-  this->parent_->queue_command(cmd);
+  this->parent_->queue_command(std::move(cmd));
 }
 
 void ModbusBinaryOutput::dump_config() {
@@ -4,7 +4,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.automation import Condition
-from esphome.components import logger
+from esphome.components import json, logger
 from esphome.const import (
     CONF_AVAILABILITY,
     CONF_BIRTH_MESSAGE,
@@ -309,6 +309,12 @@ async def to_code(config):
         await cg.register_component(trig, conf)
         await automation.build_automation(trig, [(cg.std_string, "x")], conf)
 
+    if "light" in CORE.config:
+        # Largest command for the JSON light schema: 10 root members, 5 color channels and the copied strings.
+        json.request_parse_capacity(512)
+    if config.get(CONF_ON_JSON_MESSAGE):
+        # Arbitrary user documents, leave room for a couple of nested objects.
+        json.request_parse_capacity(1024)
     for conf in config.get(CONF_ON_JSON_MESSAGE, []):
         trig = cg.new_Pvariable(conf[CONF_TRIGGER_ID], conf[CONF_TOPIC], conf[CONF_QOS])
         await automation.build_automation(trig, [(cg.JsonObjectConst, "x")], conf)
@@ -159,6 +159,8 @@ class CustomMQTTDevice {
    * }
    * ```
    *
+   * The lambda can be called more than once to build the message, so it should only fill in the object.
+   *
    * @param topic The topic to publish to.
    * @param payload The payload to publish.
    * @param qos The Quality of Service to publish with.
@@ -178,6 +180,8 @@ class CustomMQTTDevice {
    * }
    * ```
    *
+   * The lambda can be called more than once to build the message, so it should only fill in the object.
+   *
    * @param topic The topic to publish to.
    * @param payload The payload to publish.
    */
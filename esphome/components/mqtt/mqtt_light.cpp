@@ -31,8 +31,10 @@ void MQTTJSONLightComponent::setup() {
 MQTTJSONLightComponent::MQTTJSONLightComponent(LightState *state) : MQTTComponent(), state_(state) {}
 
 bool MQTTJSONLightComponent::publish_state_() {
-  return this->publish_json(this->get_state_topic_(),
-                            [this](JsonObject root) { LightJSONSchema::dump_json(*this->state_, root); });
+  std::string payload;
+  json::JsonWriter root(payload);
+  LightJSONSchema::dump_json(*this->state_, root);
+  return this->publish(this->get_state_topic_(), root.finish());
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 
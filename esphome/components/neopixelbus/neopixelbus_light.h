@@ -105,6 +105,17 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
  protected:
+  /// Layout shared by RGB and RGBW strips, stride and white channel are filled in by the subclass.
+  light::PixelBufferLayout get_pixel_buffer_layout_base_() const {
+    light::PixelBufferLayout layout;
+    layout.data = this->controller_->Pixels();
+    layout.red = this->rgb_offsets_[0];
+    layout.green = this->rgb_offsets_[1];
+    layout.blue = this->rgb_offsets_[2];
+    layout.effect_data = this->effect_data_;
+    return layout;
+  }
+
   NeoPixelBus<T_COLOR_FEATURE, T_METHOD> *controller_{nullptr};
   uint8_t *effect_data_{nullptr};
   uint8_t rgb_offsets_[4]{0, 1, 2, 3};
@@ -125,6 +136,11 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  light::PixelBufferLayout get_pixel_buffer_layout_() const override {
+    light::PixelBufferLayout layout = this->get_pixel_buffer_layout_base_();
+    layout.stride = 3;
+    return layout;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -142,6 +158,12 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  light::PixelBufferLayout get_pixel_buffer_layout_() const override {
+    light::PixelBufferLayout layout = this->get_pixel_buffer_layout_base_();
+    layout.stride = 4;
+    layout.white = this->rgb_offsets_[3];
+    return layout;
+  }
 };
 
 }  // namespace neopixelbus
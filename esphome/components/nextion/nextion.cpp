@@ -105,11 +105,10 @@ bool Nextion::check_connect_() {
 }
 
 void Nextion::reset_(bool reset_nextion) {
-  uint8_t d;
+  uint8_t d[64];
 
-  while (this->available()) {  // Clear receive buffer
-    this->read_byte(&d);
-  };
+  while (this->read_available(d, sizeof(d)) != 0) {  // Clear receive buffer
+  }
   this->nextion_queue_.clear();
 }
 
@@ -274,11 +273,11 @@ bool Nextion::remove_from_q_(bool report_empty) {
 }
 
 void Nextion::process_serial_() {
-  uint8_t d;
+  uint8_t d[64];
+  size_t len;
 
-  while (this->available()) {
-    read_byte(&d);
-    this->command_data_ += d;
+  while ((len = this->read_available(d, sizeof(d))) != 0) {
+    this->command_data_.append(reinterpret_cast<const char *>(d), len);
   }
 }
 // nextion.tech/instruction-set/
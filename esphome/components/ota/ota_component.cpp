@@ -104,6 +104,11 @@ void OTAComponent::loop() {
   }
 }
 
+bool OTAComponent::has_pending_loop_work() {
+  // Waiting for the safe mode timer needs the loop as well
+  return this->client_ != nullptr || this->server_->ready() || this->has_safe_mode_;
+}
+
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
 
 void OTAComponent::handle_() {
@@ -63,6 +63,7 @@ class OTAComponent : public Component {
   void dump_config() override;
   float get_setup_priority() const override;
   void loop() override;
+  bool has_pending_loop_work() override;
 
   uint16_t get_port() const;
 
@@ -12,9 +12,8 @@ void Pipsolar::setup() {
 }
 
 void Pipsolar::empty_uart_buffer_() {
-  uint8_t byte;
-  while (this->available()) {
-    this->read_byte(&byte);
+  uint8_t buf[64];
+  while (this->read_available(buf, sizeof(buf)) != 0) {
   }
 }
 
@@ -712,29 +711,35 @@ void Pipsolar::loop() {
   }
 
   if (this->state_ == STATE_COMMAND || this->state_ == STATE_POLL) {
-    while (this->available()) {
-      uint8_t byte;
-      this->read_byte(&byte);
-
+    // Read straight into the answer buffer, an answer ends with a carriage return
+    while (true) {
       if (this->read_pos_ == PIPSOLAR_READ_BUFFER_LENGTH) {
         this->read_pos_ = 0;
         this->empty_uart_buffer_();
       }
-      this->read_buffer_[this->read_pos_] = byte;
-      this->read_pos_++;
+      uint8_t *start = this->read_buffer_ + this->read_pos_;
+      const size_t len = this->read_available(start, PIPSOLAR_READ_BUFFER_LENGTH - this->read_pos_);
+      if (len == 0)
+        break;
+      const auto *end = static_cast<const uint8_t *>(memchr(start, 0x0D, len));
+      if (end == nullptr) {
+        this->read_pos_ += len;
+        continue;
+      }
 
       // end of answer
-      if (byte == 0x0D) {
+      this->read_pos_ = end - this->read_buffer_ + 1;
+      if (this->read_pos_ < PIPSOLAR_READ_BUFFER_LENGTH)
         this->read_buffer_[this->read_pos_] = 0;
-        this->empty_uart_buffer_();
-        if (this->state_ == STATE_POLL) {
-          this->state_ = STATE_POLL_COMPLETE;
-        }
-        if (this->state_ == STATE_COMMAND) {
-          this->state_ = STATE_COMMAND_COMPLETE;
-        }
+      this->empty_uart_buffer_();
+      if (this->state_ == STATE_POLL) {
+        this->state_ = STATE_POLL_COMPLETE;
       }
-    }  // available
+      if (this->state_ == STATE_COMMAND) {
+        this->state_ = STATE_COMMAND_COMPLETE;
+      }
+      break;
+    }
   }
   if (this->state_ == STATE_COMMAND) {
     if (millis() - this->command_start_millis_ > esphome::pipsolar::Pipsolar::COMMAND_TIMEOUT) {
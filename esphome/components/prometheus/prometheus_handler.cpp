@@ -45,6 +45,17 @@ void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
     this->switch_row_(stream, obj);
 #endif
 
+#ifdef USE_COMPONENT_PROFILING
+  this->profile_type_(stream);
+  const auto &components = App.get_components();
+  for (size_t i = 0; i < components.size(); i++) {
+    this->profile_row_(stream, components[i]->get_component_source(), i, "loop", components[i]->get_loop_profile());
+    this->profile_row_(stream, components[i]->get_component_source(), i, "scheduler",
+                       components[i]->get_scheduler_profile());
+  }
+  this->profile_row_(stream, "application", components.size(), "jitter", App.get_loop_jitter_profile());
+#endif
+
   req->send(stream);
 }
 
@@ -310,6 +321,36 @@ void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch
 }
 #endif
 
+#ifdef USE_COMPONENT_PROFILING
+void PrometheusHandler::profile_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_component_calls_total COUNTER\n"));
+  stream->print(F("#TYPE esphome_component_time_us_total COUNTER\n"));
+  stream->print(F("#TYPE esphome_component_time_us_max GAUGE\n"));
+  stream->print(F("#TYPE esphome_component_time_us_p99 GAUGE\n"));
+}
+void PrometheusHandler::profile_row_(AsyncResponseStream *stream, const char *source, size_t index, const char *kind,
+                                     const ExecutionProfile &profile) {
+  if (profile.get_count() == 0)
+    return;
+  const char *const names[] = {"esphome_component_calls_total", "esphome_component_time_us_total",
+                               "esphome_component_time_us_max", "esphome_component_time_us_p99"};
+  const uint64_t values[] = {profile.get_count(), profile.get_total_us(), profile.get_max_us(),
+                             profile.get_percentile_us(99.0f)};
+  for (size_t i = 0; i < 4; i++) {
+    stream->print(names[i]);
+    stream->print(F("{source=\""));
+    stream->print(source);
+    stream->print(F("\",index=\""));
+    stream->print(index);
+    stream->print(F("\",kind=\""));
+    stream->print(kind);
+    stream->print(F("\"} "));
+    stream->print(uint64_to_string(values[i]).c_str());
+    stream->print('\n');
+  }
+}
+#endif
+
 }  // namespace prometheus
 }  // namespace esphome
 
@@ -76,6 +76,14 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
   void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
 #endif
 
+#ifdef USE_COMPONENT_PROFILING
+  /// Return the type for prometheus
+  void profile_type_(AsyncResponseStream *stream);
+  /// Return the execution time statistics of a component as prometheus data points
+  void profile_row_(AsyncResponseStream *stream, const char *source, size_t index, const char *kind,
+                    const ExecutionProfile &profile);
+#endif
+
   web_server_base::WebServerBase *base_;
 };
 
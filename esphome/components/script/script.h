@@ -117,7 +117,8 @@ template<typename... Ts> class ScriptWaitAction : public Action<Ts...>, public C
       this->play_next_(x...);
       return;
     }
-    this->var_ = std::make_tuple(x...);
+    // Assign element-wise so the stored arguments reuse their buffers
+    this->var_ = std::forward_as_tuple(x...);
     this->loop();
   }
 
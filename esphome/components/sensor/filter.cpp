@@ -2,6 +2,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "sensor.h"
+#include <algorithm>
 #include <cmath>
 
 namespace esphome {
@@ -31,17 +32,88 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
+// SortedWindow
+void SortedWindow::set_window_size(size_t window_size) {
+  // collect the newest values in arrival order
+  std::vector<float> values;
+  values.reserve(this->ring_.size());
+  values.insert(values.end(), this->ring_.begin() + this->head_, this->ring_.end());
+  values.insert(values.end(), this->ring_.begin(), this->ring_.begin() + this->head_);
+  if (values.size() > window_size)
+    values.erase(values.begin(), values.end() - window_size);
+
+  this->window_size_ = window_size;
+  this->head_ = 0;
+  this->ring_.clear();
+  this->ring_.shrink_to_fit();
+  this->ring_.reserve(window_size);
+  this->sorted_.clear();
+  this->sorted_.shrink_to_fit();
+  this->sorted_.reserve(window_size);
+  for (float value : values)
+    this->push(value);
+}
+void SortedWindow::push(float value) {
+  if (this->window_size_ == 0)
+    return;
+
+  if (this->ring_.size() < this->window_size_) {
+    this->ring_.push_back(value);
+  } else {
+    float &oldest = this->ring_[this->head_];
+    this->sorted_.erase(std::lower_bound(this->sorted_.begin(), this->sorted_.end(), oldest));
+    oldest = value;
+    if (++this->head_ == this->window_size_)
+      this->head_ = 0;
+  }
+  this->sorted_.insert(std::upper_bound(this->sorted_.begin(), this->sorted_.end(), value), value);
+}
+
+// MonotonicWindow
+void MonotonicWindow::set_window_size(size_t window_size) {
+  std::vector<Entry> entries;
+  entries.reserve(window_size);
+  for (size_t i = 0; i < this->count_; i++) {
+    // drop entries that are older than the newest window_size values
+    if (this->seq_ - this->at_(i).seq <= window_size)
+      entries.push_back(this->at_(i));
+  }
+
+  this->head_ = 0;
+  this->count_ = entries.size();
+  entries.resize(window_size);
+  this->entries_ = std::move(entries);
+}
+void MonotonicWindow::push(float value) {
+  const size_t window_size = this->entries_.size();
+  if (window_size == 0)
+    return;
+
+  // remove the oldest value once it's outside the window
+  if (this->count_ != 0 && this->seq_ - this->entries_[this->head_].seq >= window_size) {
+    if (++this->head_ == window_size)
+      this->head_ = 0;
+    this->count_--;
+  }
+  // remove values that can never be the extreme again, as the new value is both newer and more extreme
+  while (this->count_ != 0 && this->supersedes_(value, this->at_(this->count_ - 1).value))
+    this->count_--;
+
+  this->at_(this->count_) = Entry{this->seq_++, value};
+  this->count_++;
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> MedianFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -49,15 +121,12 @@ optional<float> MedianFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
+    if (!this->window_.empty()) {
+      size_t window_size = this->window_.size();
+      if (window_size % 2) {
+        median = this->window_[window_size / 2];
       } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
+        median = (this->window_[window_size / 2] + this->window_[(window_size / 2) - 1]) / 2.0f;
       }
     }
 
@@ -69,16 +138,20 @@ optional<float> MedianFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : window_(window_size),
+      send_every_(send_every),
+      send_at_(send_every - send_first_at),
+      window_size_(window_size),
+      quantile_(quantile) {}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
   }
 
@@ -86,14 +159,11 @@ optional<float> QuantileFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float result = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> quantile_queue = this->queue_;
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      size_t position = ceilf(queue_size * this->quantile_) - 1;
-      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position, queue_size);
-      result = quantile_queue[position];
+    if (!this->window_.empty()) {
+      size_t window_size = this->window_.size();
+      size_t position = ceilf(window_size * this->quantile_) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position, window_size);
+      result = this->window_[position];
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING", this, result);
@@ -104,15 +174,18 @@ optional<float> QuantileFilter::new_value(float value) {
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, false),
+      send_every_(send_every),
+      send_at_(send_every - send_first_at),
+      window_size_(window_size) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> MinFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -120,9 +193,8 @@ optional<float> MinFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float min = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::min_element(queue_.begin(), queue_.end());
-      min = *it;
+    if (!this->window_.empty()) {
+      min = this->window_.front();
     }
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING", this, min);
@@ -133,15 +205,18 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, true),
+      send_every_(send_every),
+      send_at_(send_every - send_first_at),
+      window_size_(window_size) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> MaxFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -149,9 +224,8 @@ optional<float> MaxFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float max = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::max_element(queue_.begin(), queue_.end());
-      max = *it;
+    if (!this->window_.empty()) {
+      max = this->window_.front();
     }
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING", this, max);
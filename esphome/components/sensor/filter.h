@@ -4,6 +4,7 @@
 #include "esphome/core/helpers.h"
 #include <queue>
 #include <utility>
+#include <vector>
 
 namespace esphome {
 namespace sensor {
@@ -42,6 +43,70 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/** Window of the last values, additionally kept in sorted order for order statistics like the median.
+ *
+ * Both buffers are allocated once for the window size. Adding a value costs a binary search and a move of the
+ * values after it, which for the window sizes used on devices is faster than a tree or skiplist.
+ */
+class SortedWindow {
+ public:
+  explicit SortedWindow(size_t window_size) { this->set_window_size(window_size); }
+
+  /// Change the window size, keeping the newest values.
+  void set_window_size(size_t window_size);
+  /// Add a value, dropping the oldest value if the window is full.
+  void push(float value);
+
+  bool empty() const { return this->sorted_.empty(); }
+  size_t size() const { return this->sorted_.size(); }
+  /// The i-th smallest value in the window.
+  float operator[](size_t i) const { return this->sorted_[i]; }
+
+ protected:
+  std::vector<float> ring_;    ///< Values in arrival order, oldest at head_ once the window is full.
+  std::vector<float> sorted_;  ///< The same values, sorted.
+  size_t head_{0};
+  size_t window_size_{0};
+};
+
+/** Window of the last values that tracks their minimum (or maximum) with a monotonic queue.
+ *
+ * Only values that can still become the extreme are stored, so adding a value is amortized O(1) and the extreme
+ * is always at the front.
+ */
+class MonotonicWindow {
+ public:
+  MonotonicWindow(size_t window_size, bool max) : max_(max) { this->set_window_size(window_size); }
+
+  /// Change the window size, keeping the newest values.
+  void set_window_size(size_t window_size);
+  /// Add a value, dropping the oldest value if the window is full.
+  void push(float value);
+
+  bool empty() const { return this->count_ == 0; }
+  /// The minimum (or maximum) of the values in the window.
+  float front() const { return this->entries_[this->head_].value; }
+
+ protected:
+  struct Entry {
+    uint32_t seq;
+    float value;
+  };
+
+  /// Whether value a makes an older value b irrelevant.
+  bool supersedes_(float a, float b) const { return this->max_ ? a >= b : a <= b; }
+  Entry &at_(size_t i) {
+    size_t index = this->head_ + i;
+    return this->entries_[index < this->entries_.size() ? index : index - this->entries_.size()];
+  }
+
+  std::vector<Entry> entries_;  ///< Ring buffer of window_size entries, count_ in use starting at head_.
+  size_t head_{0};
+  size_t count_{0};
+  uint32_t seq_{0};  ///< Sequence number of the next value.
+  bool max_;
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
@@ -66,7 +131,7 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -95,7 +160,7 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -123,7 +188,7 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -151,7 +216,7 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
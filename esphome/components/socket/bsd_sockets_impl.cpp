@@ -1,6 +1,7 @@
 #include "socket.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/application.h"
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
@@ -9,6 +10,8 @@
 #ifdef USE_ESP32
 #include <esp_idf_version.h>
 #include <lwip/sockets.h>
+#else
+#include <sys/select.h>
 #endif
 
 namespace esphome {
@@ -35,7 +38,11 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
 
 class BSDSocketImpl : public Socket {
  public:
-  BSDSocketImpl(int fd) : Socket(), fd_(fd) {}
+  BSDSocketImpl(int fd) : Socket(), fd_(fd) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    App.register_socket_fd(fd_);
+#endif
+  }
   ~BSDSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -49,6 +56,9 @@ class BSDSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    App.unregister_socket_fd(fd_);
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -80,6 +90,14 @@ class BSDSocketImpl : public Socket {
     return ::setsockopt(fd_, level, optname, optval, optlen);
   }
   int listen(int backlog) override { return ::listen(fd_, backlog); }
+  bool ready() const override {
+    // There's no callback when data arrives, so the loop only notices at its next wakeup
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(fd_, &read_fds);
+    struct timeval timeout = {0, 0};
+    return ::select(fd_ + 1, &read_fds, nullptr, nullptr, &timeout) != 0;
+  }
   ssize_t read(void *buf, size_t len) override { return ::read(fd_, buf, len); }
   ssize_t readv(const struct iovec *iov, int iovcnt) override {
 #if defined(USE_ESP32) && ESP_IDF_VERSION_MAJOR < 4
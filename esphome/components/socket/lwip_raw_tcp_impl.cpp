@@ -11,6 +11,7 @@
 #include <cstring>
 #include <queue>
 
+#include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -487,6 +488,9 @@ class LWIPRawImpl : public Socket {
     }
     return 0;
   }
+  bool ready() const override {
+    return pcb_ == nullptr || rx_buf_ != nullptr || rx_closed_ || !accepted_sockets_.empty();
+  }
 
   err_t accept_fn(struct tcp_pcb *newpcb, err_t err) {
     LWIP_LOG("accept(newpcb=%p err=%d)", newpcb, err);
@@ -500,6 +504,7 @@ class LWIPRawImpl : public Socket {
     auto sock = make_unique<LWIPRawImpl>(newpcb);
     sock->init();
     accepted_sockets_.push(std::move(sock));
+    App.wake_loop();
     return ERR_OK;
   }
   void err_fn(err_t err) {
@@ -510,6 +515,7 @@ class LWIPRawImpl : public Socket {
     // ERR_RST: connection was reset by remote host
     // ERR_ABRT: aborted through tcp_abort or TCP timer
     pcb_ = nullptr;
+    App.wake_loop();
   }
   err_t recv_fn(struct pbuf *pb, err_t err) {
     LWIP_LOG("recv(pb=%p err=%d)", pb, err);
@@ -517,10 +523,12 @@ class LWIPRawImpl : public Socket {
       // "An error code if there has been an error receiving Only return ERR_ABRT if you have
       // called tcp_abort from within the callback function!"
       rx_closed_ = true;
+      App.wake_loop();
       return ERR_OK;
     }
     if (pb == nullptr) {
       rx_closed_ = true;
+      App.wake_loop();
       return ERR_OK;
     }
     if (rx_buf_ == nullptr) {
@@ -530,6 +538,7 @@ class LWIPRawImpl : public Socket {
     } else {
       pbuf_cat(rx_buf_, pb);
     }
+    App.wake_loop();
     return ERR_OK;
   }
 
@@ -36,6 +36,12 @@ class Socket {
   virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+  /** Whether read() or accept() would return something right away, or report an error.
+   *
+   * Used by the event-driven loop to skip components with idle sockets. Implementations that can tell when data
+   * arrives also wake up the loop with App.wake_loop().
+   */
+  virtual bool ready() const { return true; }
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol);
@@ -142,8 +142,17 @@ void SSD1306::setup() {
   this->turn_on();
 }
 void SSD1306::display() {
+  // only write the pages (rows of 8 pixels) that changed
+  int x1, y1, x2, y2;
+  if (!this->take_dirty_region_(&x1, &y1, &x2, &y2))
+    return;
+  int first_page = y1 / 8;
+  int last_page = y2 / 8;
+  if (!this->skip_unchanged_lines_(&first_page, &last_page, this->get_width_internal()))
+    return;
+
   if (this->is_sh1106_()) {
-    this->write_display_data();
+    this->write_display_data(first_page, last_page);
     return;
   }
 
@@ -161,12 +170,12 @@ void SSD1306::display() {
   }
 
   this->command(SSD1306_COMMAND_PAGE_ADDRESS);
-  // Page start address, 0
-  this->command(0);
+  // Page start address
+  this->command(first_page);
   // Page end address:
-  this->command((this->get_height_internal() / 8) - 1);
+  this->command(last_page);
 
-  this->write_display_data();
+  this->write_display_data(first_page, last_page);
 }
 bool SSD1306::is_sh1106_() const {
   return this->model_ == SH1106_MODEL_96_16 || this->model_ == SH1106_MODEL_128_32 ||
@@ -257,16 +266,50 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
 
   uint16_t pos = x + (y / 8) * this->get_width_internal();
   uint8_t subpos = y & 0x07;
+  uint8_t old = this->buffer_[pos];
   if (color.is_on()) {
     this->buffer_[pos] |= (1 << subpos);
   } else {
     this->buffer_[pos] &= ~(1 << subpos);
   }
+  if (this->buffer_[pos] != old)
+    this->mark_dirty_(x, y);
+}
+void HOT SSD1306::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+    return;
+
+  const int buffer_width = this->get_width_internal();
+  const bool on = color.is_on();
+  bool changed = false;
+  // each byte holds a column of 8 rows (a page), so set all rows of a page at once
+  for (int page = y / 8; page <= (y + height - 1) / 8; page++) {
+    const int first = std::max(y - page * 8, 0);
+    const int last = std::min(y + height - 1 - page * 8, 7);
+    const uint8_t mask = (0xFF >> (7 - last)) & (0xFF << first);
+    uint8_t *dst = this->buffer_ + page * buffer_width + x;
+    for (int i = 0; i < width; i++) {
+      const uint8_t value = on ? (dst[i] | mask) : (dst[i] & ~mask);
+      if (dst[i] != value) {
+        dst[i] = value;
+        changed = true;
+      }
+    }
+  }
+  if (changed) {
+    this->mark_dirty_(x, y);
+    this->mark_dirty_(x + width - 1, y + height - 1);
+  }
 }
 void SSD1306::fill(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
-  for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
-    this->buffer_[i] = fill;
+  const int width = this->get_width_internal();
+  for (uint32_t i = 0; i < this->get_buffer_length_(); i++) {
+    if (this->buffer_[i] != fill) {
+      this->buffer_[i] = fill;
+      this->mark_dirty_(i % width, (i / width) * 8);
+    }
+  }
 }
 void SSD1306::init_reset_() {
   if (this->reset_pin_ != nullptr) {
@@ -50,13 +50,15 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
 
  protected:
   virtual void command(uint8_t value) = 0;
-  virtual void write_display_data() = 0;
+  /// Write the given pages (rows of 8 pixels) of the buffer, after the addressing window has been set up.
+  virtual void write_display_data(uint8_t first_page, uint8_t last_page) = 0;
   void init_reset_();
 
   bool is_sh1106_() const;
   bool is_ssd1305_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
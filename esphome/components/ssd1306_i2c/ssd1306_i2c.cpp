@@ -37,10 +37,11 @@ void I2CSSD1306::dump_config() {
   }
 }
 void I2CSSD1306::command(uint8_t value) { this->write_byte(0x00, value); }
-void HOT I2CSSD1306::write_display_data() {
+void HOT I2CSSD1306::write_display_data(uint8_t first_page, uint8_t last_page) {
+  const uint32_t width = this->get_width_internal();
   if (this->is_sh1106_()) {
-    uint32_t i = 0;
-    for (uint8_t page = 0; page < (uint8_t) this->get_height_internal() / 8; page++) {
+    uint32_t i = first_page * width;
+    for (uint8_t page = first_page; page <= last_page; page++) {
       this->command(0xB0 + page);  // row
       this->command(0x02);         // lower column
       this->command(0x10);         // higher column
@@ -53,7 +54,7 @@ void HOT I2CSSD1306::write_display_data() {
       }
     }
   } else {
-    for (uint32_t i = 0; i < this->get_buffer_length_();) {
+    for (uint32_t i = first_page * width; i < (last_page + 1u) * width;) {
       uint8_t data[16];
       for (uint8_t &j : data)
         j = this->buffer_[i++];
@@ -35,9 +35,10 @@ void SPISSD1306::command(uint8_t value) {
   this->write_byte(value);
   this->disable();
 }
-void HOT SPISSD1306::write_display_data() {
+void HOT SPISSD1306::write_display_data(uint8_t first_page, uint8_t last_page) {
+  const uint32_t width = this->get_width_internal();
   if (this->is_sh1106_()) {
-    for (uint8_t y = 0; y < (uint8_t) this->get_height_internal() / 8; y++) {
+    for (uint8_t y = first_page; y <= last_page; y++) {
       this->command(0xB0 + y);
       this->command(0x02);
       this->command(0x10);
@@ -52,7 +53,7 @@ void HOT SPISSD1306::write_display_data() {
   } else {
     this->dc_pin_->digital_write(true);
     this->enable();
-    this->write_array(this->buffer_, this->get_buffer_length_());
+    this->write_array(this->buffer_ + first_page * width, (last_page - first_page + 1u) * width);
     this->disable();
   }
 }
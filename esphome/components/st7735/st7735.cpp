@@ -312,14 +312,60 @@ void HOT ST7735::draw_absolute_pixel_internal(int x, int y, Color color) {
     return;
 
   if (this->eightbitcolor_) {
-    const uint32_t color332 = display::ColorUtil::color_to_332(color);
+    const uint8_t color332 = display::ColorUtil::color_to_332(color);
     uint16_t pos = (x + y * this->get_width_internal());
+    if (this->buffer_[pos] == color332)
+      return;
     this->buffer_[pos] = color332;
   } else {
     const uint32_t color565 = display::ColorUtil::color_to_565(color);
+    const uint8_t high = (color565 >> 8) & 0xff;
+    const uint8_t low = color565 & 0xff;
     uint16_t pos = (x + y * this->get_width_internal()) * 2;
-    this->buffer_[pos++] = (color565 >> 8) & 0xff;
-    this->buffer_[pos] = color565 & 0xff;
+    if (this->buffer_[pos] == high && this->buffer_[pos + 1] == low)
+      return;
+    this->buffer_[pos++] = high;
+    this->buffer_[pos] = low;
+  }
+  // only send the window of changed pixels to the display
+  this->mark_dirty_(x, y);
+}
+
+void HOT ST7735::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->clip_absolute_rect_(&x, &y, &width, &height))
+    return;
+
+  const size_t buffer_width = this->get_width_internal();
+  bool changed = false;
+  if (this->eightbitcolor_) {
+    const uint8_t color332 = display::ColorUtil::color_to_332(color);
+    for (int row = y; row < y + height; row++) {
+      uint8_t *dst = this->buffer_ + row * buffer_width + x;
+      for (int i = 0; i < width; i++) {
+        if (dst[i] != color332) {
+          dst[i] = color332;
+          changed = true;
+        }
+      }
+    }
+  } else {
+    const uint32_t color565 = display::ColorUtil::color_to_565(color);
+    const uint8_t high = (color565 >> 8) & 0xff;
+    const uint8_t low = color565 & 0xff;
+    for (int row = y; row < y + height; row++) {
+      uint8_t *dst = this->buffer_ + (row * buffer_width + x) * 2;
+      for (int i = 0; i < width * 2; i += 2) {
+        if (dst[i] != high || dst[i + 1] != low) {
+          dst[i] = high;
+          dst[i + 1] = low;
+          changed = true;
+        }
+      }
+    }
+  }
+  if (changed) {
+    this->mark_dirty_(x, y);
+    this->mark_dirty_(x + width - 1, y + height - 1);
   }
 }
 
@@ -418,36 +464,43 @@ void HOT ST7735::senddata_(const uint8_t *data_bytes, uint8_t num_data_bytes) {
 }
 
 void HOT ST7735::write_display_data_() {
+  int x, y, x2, y2;
+  const size_t width = this->get_width_internal();
+  if (!this->take_dirty_region_(&x, &y, &x2, &y2) ||
+      !this->skip_unchanged_lines_(&y, &y2, this->eightbitcolor_ ? width : width * 2))
+    return;
+
   uint16_t offsetx = colstart_;
   uint16_t offsety = rowstart_;
 
-  uint16_t x1 = offsetx;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = offsety;
-  uint16_t y2 = y1 + get_height_internal() - 1;
-
   this->enable();
 
   // set column(x) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_CASET);
   this->dc_pin_->digital_write(true);
-  this->spi_master_write_addr_(x1, x2);
+  this->spi_master_write_addr_(offsetx + x, offsetx + x2);
 
   // set Page(y) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_RASET);
   this->dc_pin_->digital_write(true);
-  this->spi_master_write_addr_(y1, y2);
+  this->spi_master_write_addr_(offsety + y, offsety + y2);
 
   //  Memory Write
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_RAMWR);
   this->dc_pin_->digital_write(true);
 
-  if (this->eightbitcolor_) {
-    for (size_t line = 0; line < this->get_buffer_length(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
+  if (!this->eightbitcolor_ && x == 0 && x2 == int(width) - 1) {
+    // full lines are contiguous in the buffer
+    this->write_array(this->buffer_ + y * width * 2, (y2 - y + 1) * width * 2);
+    y = y2 + 1;
+  }
+  for (; y <= y2; y++) {
+    if (this->eightbitcolor_) {
+      const size_t line = y * width;
+      for (int index = x; index <= x2; ++index) {
         auto color332 = display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
                                                      display::ColorBitness::COLOR_BITNESS_332, true);
 
@@ -456,9 +509,9 @@ void HOT ST7735::write_display_data_() {
         this->write_byte((color >> 8) & 0xff);
         this->write_byte(color & 0xff);
       }
+    } else {
+      this->write_array(this->buffer_ + (y * width + x) * 2, (x2 - x + 1) * 2);
     }
-  } else {
-    this->write_array(this->buffer_, this->get_buffer_length());
   }
   this->disable();
 }
@@ -45,9 +45,16 @@ bool TeleInfo::read_chars_until_(bool drop, uint8_t c) {
   uint8_t received;
   int j = 0;
 
-  while (available() > 0 && j < 128) {
+  while (j < 128) {
+    /* Read the UART in chunks, bytes after c are kept for the next call. */
+    if (chunk_pos_ == chunk_len_) {
+      chunk_pos_ = 0;
+      chunk_len_ = read_available(chunk_, sizeof(chunk_));
+      if (chunk_len_ == 0)
+        break;
+    }
     j++;
-    received = read();
+    received = chunk_[chunk_pos_++];
     if (received == c)
       return true;
     if (drop)
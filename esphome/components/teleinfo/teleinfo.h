@@ -35,6 +35,10 @@ class TeleInfo : public PollingComponent, public uart::UARTDevice {
   int separator_;
   char buf_[MAX_BUF_SIZE];
   uint32_t buf_index_{0};
+  /* UART data is read in chunks and then handled byte by byte from here. */
+  uint8_t chunk_[64];
+  uint8_t chunk_pos_{0};
+  uint8_t chunk_len_{0};
   char tag_[MAX_TAG_SIZE];
   char val_[MAX_VAL_SIZE];
   char timestamp_[MAX_TIMESTAMP_SIZE];
@@ -16,10 +16,11 @@ void Tuya::setup() {
 }
 
 void Tuya::loop() {
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    this->handle_char_(c);
+  uint8_t buf[64];
+  size_t len;
+  while ((len = this->read_available(buf, sizeof(buf))) != 0) {
+    for (size_t i = 0; i < len; i++)
+      this->handle_char_(buf[i]);
   }
   process_command_queue_();
 }
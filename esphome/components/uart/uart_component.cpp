@@ -1,10 +1,21 @@
 #include "uart_component.h"
+#include <algorithm>
 
 namespace esphome {
 namespace uart {
 
 static const char *const TAG = "uart";
 
+size_t UARTComponent::read_available(uint8_t *data, size_t max_len) {
+  const int available = this->available();
+  if (available <= 0 || max_len == 0)
+    return 0;
+  const size_t len = std::min<size_t>(available, max_len);
+  if (!this->read_array(data, len))
+    return 0;
+  return len;
+}
+
 bool UARTComponent::check_read_timeout_(size_t len) {
   if (this->available() >= int(len))
     return true;
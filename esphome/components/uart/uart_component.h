@@ -43,6 +43,9 @@ class UARTComponent {
   bool read_byte(uint8_t *data) { return this->read_array(data, 1); };
   virtual bool peek_byte(uint8_t *data) = 0;
   virtual bool read_array(uint8_t *data, size_t len) = 0;
+  /// Read up to max_len of the bytes that have already been received, without waiting for more.
+  /// Returns the number of bytes read.
+  size_t read_available(uint8_t *data, size_t max_len);
 
   /// Return available number of bytes.
   virtual int available() = 0;
@@ -64,7 +67,8 @@ class UARTComponent {
   uint32_t get_baud_rate() const { return baud_rate_; }
 
 #ifdef USE_UART_DEBUGGER
-  void add_debug_callback(std::function<void(UARTDirection, uint8_t)> &&callback) {
+  /// Register a callback that is called with every chunk of data that is sent or received.
+  void add_debug_callback(std::function<void(UARTDirection, const uint8_t *, size_t)> &&callback) {
     this->debug_callback_.add(std::move(callback));
   }
 #endif
@@ -81,7 +85,7 @@ class UARTComponent {
   uint8_t data_bits_;
   UARTParityOptions parity_;
 #ifdef USE_UART_DEBUGGER
-  CallbackManager<void(UARTDirection, uint8_t)> debug_callback_{};
+  CallbackManager<void(UARTDirection, const uint8_t *, size_t)> debug_callback_{};
 #endif
 };
 
@@ -136,9 +136,7 @@ void ESP8266UartComponent::write_array(const uint8_t *data, size_t len) {
       this->sw_serial_->write_byte(data[i]);
   }
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
-  }
+  this->debug_callback_.call(UART_DIRECTION_TX, data, len);
 #endif
 }
 bool ESP8266UartComponent::peek_byte(uint8_t *data) {
@@ -161,9 +159,7 @@ bool ESP8266UartComponent::read_array(uint8_t *data, size_t len) {
       data[i] = this->sw_serial_->read_byte();
   }
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
-  }
+  this->debug_callback_.call(UART_DIRECTION_RX, data, len);
 #endif
   return true;
 }
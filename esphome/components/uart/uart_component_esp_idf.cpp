@@ -131,9 +131,7 @@ void IDFUARTComponent::write_array(const uint8_t *data, size_t len) {
   uart_write_bytes(this->uart_num_, data, len);
   xSemaphoreGive(this->lock_);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
-  }
+  this->debug_callback_.call(UART_DIRECTION_TX, data, len);
 #endif
 }
 
@@ -161,19 +159,18 @@ bool IDFUARTComponent::read_array(uint8_t *data, size_t len) {
   if (!this->check_read_timeout_(len))
     return false;
   xSemaphoreTake(this->lock_, portMAX_DELAY);
+  uint8_t *read_to = data;
   if (this->has_peek_) {
     length_to_read--;
-    *data = this->peek_byte_;
-    data++;
+    *read_to = this->peek_byte_;
+    read_to++;
     this->has_peek_ = false;
   }
   if (length_to_read > 0)
-    uart_read_bytes(this->uart_num_, data, length_to_read, 20 / portTICK_RATE_MS);
+    uart_read_bytes(this->uart_num_, read_to, length_to_read, 20 / portTICK_RATE_MS);
   xSemaphoreGive(this->lock_);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
-  }
+  this->debug_callback_.call(UART_DIRECTION_RX, data, len);
 #endif
   return true;
 }
@@ -316,14 +316,15 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "sensor-" + obj->get_object_id();
-    std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-    if (!obj->get_unit_of_measurement().empty())
-      state += " " + obj->get_unit_of_measurement();
-    root["state"] = state;
-    root["value"] = value;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "sensor-" + obj->get_object_id());
+  std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+  if (!obj->get_unit_of_measurement().empty())
+    state += " " + obj->get_unit_of_measurement();
+  root.add("state", state);
+  root.add("value", value);
+  return root.finish();
 }
 #endif
 
@@ -342,11 +343,12 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
   request->send(404);
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "text_sensor-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "text_sensor-" + obj->get_object_id());
+  root.add("state", value);
+  root.add("value", value);
+  return root.finish();
 }
 #endif
 
@@ -355,11 +357,12 @@ void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
   this->events_.send(this->switch_json(obj, state).c_str(), "state");
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "switch-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "switch-" + obj->get_object_id());
+  root.add("state", value ? "ON" : "OFF");
+  root.add("value", value);
+  return root.finish();
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (switch_::Switch *obj : App.get_switches()) {
@@ -410,11 +413,12 @@ void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
   this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "binary_sensor-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "binary_sensor-" + obj->get_object_id());
+  root.add("state", value ? "ON" : "OFF");
+  root.add("value", value);
+  return root.finish();
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
@@ -431,32 +435,33 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 #ifdef USE_FAN
 void WebServer::on_fan_update(fan::FanState *obj) { this->events_.send(this->fan_json(obj).c_str(), "state"); }
 std::string WebServer::fan_json(fan::FanState *obj) {
-  return json::build_json([obj](JsonObject root) {
-    root["id"] = "fan-" + obj->get_object_id();
-    root["state"] = obj->state ? "ON" : "OFF";
-    root["value"] = obj->state;
-    const auto traits = obj->get_traits();
-    if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "fan-" + obj->get_object_id());
+  root.add("state", obj->state ? "ON" : "OFF");
+  root.add("value", obj->state);
+  const auto traits = obj->get_traits();
+  if (traits.supports_speed()) {
+    root.add("speed_level", obj->speed);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-      // NOLINTNEXTLINE(clang-diagnostic-deprecated-declarations)
-      switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
-        case fan::FAN_SPEED_LOW:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "low";
-          break;
-        case fan::FAN_SPEED_MEDIUM:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "medium";
-          break;
-        case fan::FAN_SPEED_HIGH:  // NOLINT(clang-diagnostic-deprecated-declarations)
-          root["speed"] = "high";
-          break;
-      }
-#pragma GCC diagnostic pop
+    // NOLINTNEXTLINE(clang-diagnostic-deprecated-declarations)
+    switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
+      case fan::FAN_SPEED_LOW:  // NOLINT(clang-diagnostic-deprecated-declarations)
+        root.add("speed", "low");
+        break;
+      case fan::FAN_SPEED_MEDIUM:  // NOLINT(clang-diagnostic-deprecated-declarations)
+        root.add("speed", "medium");
+        break;
+      case fan::FAN_SPEED_HIGH:  // NOLINT(clang-diagnostic-deprecated-declarations)
+        root.add("speed", "high");
+        break;
     }
-    if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
-  });
+#pragma GCC diagnostic pop
+  }
+  if (obj->get_traits().supports_oscillation())
+    root.add("oscillation", obj->oscillating);
+  return root.finish();
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (fan::FanState *obj : App.get_fans()) {
@@ -580,11 +585,14 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj) {
-  return json::build_json([obj](JsonObject root) {
-    root["id"] = "light-" + obj->get_object_id();
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
-    light::LightJSONSchema::dump_json(*obj, root);
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "light-" + obj->get_object_id());
+  // dump_json() includes the state for all known color modes
+  if (!(obj->remote_values.get_color_mode() & light::ColorCapability::ON_OFF))
+    root.add("state", obj->remote_values.is_on() ? "ON" : "OFF");
+  light::LightJSONSchema::dump_json(*obj, root);
+  return root.finish();
 }
 #endif
 
@@ -632,15 +640,16 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject root) {
-    root["id"] = "cover-" + obj->get_object_id();
-    root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
-    root["value"] = obj->position;
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "cover-" + obj->get_object_id());
+  root.add("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+  root.add("value", obj->position);
+  root.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
+
+  if (obj->get_traits().get_supports_tilt())
+    root.add("tilt", obj->tilt);
+  return root.finish();
 }
 #endif
 
@@ -659,13 +668,14 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::number_json(number::Number *obj, float value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "number-" + obj->get_object_id();
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "%f", value);
-    root["state"] = buffer;
-    root["value"] = value;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "number-" + obj->get_object_id());
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%f", value);
+  root.add("state", buffer);
+  root.add("value", value);
+  return root.finish();
 }
 #endif
 
@@ -703,11 +713,12 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject root) {
-    root["id"] = "select-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
-  });
+  std::string output;
+  json::JsonWriter root(output);
+  root.add("id", "select-" + obj->get_object_id());
+  root.add("state", value);
+  root.add("value", value);
+  return root.finish();
 }
 #endif
 
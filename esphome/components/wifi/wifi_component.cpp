@@ -117,6 +117,8 @@ void WiFiComponent::loop() {
       case WIFI_COMPONENT_STATE_STA_CONNECTED: {
         if (!this->is_connected()) {
           ESP_LOGW(TAG, "WiFi Connection lost... Reconnecting...");
+          // The event-driven loop doesn't run while connected, so the timeouts count from here
+          this->last_connected_ = now;
           this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTING;
           this->retry_connect();
         } else {
@@ -158,6 +160,14 @@ void WiFiComponent::loop() {
   }
 }
 
+bool WiFiComponent::has_pending_loop_work() {
+  // Scanning, connecting and the fallback AP are driven from loop(), once connected it only has to notice a lost
+  // connection
+  if (!this->has_sta() || this->state_ != WIFI_COMPONENT_STATE_STA_CONNECTED)
+    return true;
+  return this->wifi_has_pending_events_() || !this->is_connected();
+}
+
 WiFiComponent::WiFiComponent() { global_wifi_component = this; }
 
 bool WiFiComponent::has_ap() const { return this->has_ap_; }
@@ -215,6 +215,7 @@ class WiFiComponent : public Component {
 
   /// Reconnect WiFi if required.
   void loop() override;
+  bool has_pending_loop_work() override;
 
   bool has_sta() const;
   bool has_ap() const;
@@ -263,6 +264,8 @@ class WiFiComponent : public Component {
   void print_connect_params_();
 
   void wifi_loop_();
+  /// Whether the platform queued events for wifi_loop_() to process.
+  bool wifi_has_pending_events_();
   bool wifi_mode_(optional<bool> sta, optional<bool> ap);
   bool wifi_sta_pre_setup_();
   bool wifi_apply_output_power_(float output_power);
@@ -106,7 +106,9 @@ void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, voi
   // don't block, we may miss events but the core can handle that
   if (xQueueSend(s_event_queue, &to_send, 0L) != pdPASS) {
     delete to_send;  // NOLINT(cppcoreguidelines-owning-memory)
+    return;
   }
+  App.wake_loop();
 }
 
 void WiFiComponent::wifi_pre_setup_() {
@@ -580,6 +582,7 @@ void WiFiComponent::wifi_loop_() {
     delete data;  // NOLINT(cppcoreguidelines-owning-memory)
   }
 }
+bool WiFiComponent::wifi_has_pending_events_() { return uxQueueMessagesWaiting(s_event_queue) != 0; }
 void WiFiComponent::wifi_process_event_(IDFWiFiEvent *data) {
   esp_err_t err;
   if (data->event_base == WIFI_EVENT && data->event_id == WIFI_EVENT_STA_START) {
@@ -7,10 +7,27 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include <algorithm>
+#include <cstring>
+#ifdef USE_ESP32
+#include <lwip/sockets.h>
+#else
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+// Maximum time to sleep in event-driven mode when nothing is scheduled, so that the watchdog still gets fed.
+static const uint32_t MAX_EVENT_DRIVEN_SLEEP = 1000;
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -66,9 +83,24 @@ void Application::setup() {
 void Application::loop() {
   uint32_t new_app_state = 0;
 
+#ifdef USE_COMPONENT_PROFILING
+  if (this->next_loop_us_ != 0) {
+    // Woken up early by wake_loop(), which is no delay
+    const int32_t late = static_cast<int32_t>(micros() - this->next_loop_us_);
+    this->loop_jitter_profile_.record(late > 0 ? late : 0);
+  }
+#endif
+
   this->scheduler.call();
   this->feed_wdt();
+  bool polled = false;
   for (Component *component : this->looping_components_) {
+    if (this->event_driven_loop_) {
+      // Failed components aren't looped anyway, and might not be able to tell whether they have work
+      if (component->is_failed() || !component->has_pending_loop_work())
+        continue;
+      polled = true;
+    }
     {
       WarnIfComponentBlockingGuard guard{component};
       component->call();
@@ -82,18 +114,33 @@ void Application::loop() {
   const uint32_t now = millis();
 
   if (HighFrequencyLoopRequester::is_high_frequency()) {
+#ifdef USE_COMPONENT_PROFILING
+    this->next_loop_us_ = micros();
+#endif
     yield();
   } else {
-    uint32_t delay_time = this->loop_interval_;
-    if (now - this->last_loop_ < this->loop_interval_)
-      delay_time = this->loop_interval_ - (now - this->last_loop_);
+    uint32_t loop_interval = this->loop_interval_;
+    // Nothing to poll, sleep until the next scheduled item or a wakeup. Keep dumping the config at the normal rate.
+    if (this->event_driven_loop_ && !polled && this->dump_config_at_ >= this->components_.size())
+      loop_interval = MAX_EVENT_DRIVEN_SLEEP;
+
+    uint32_t delay_time = loop_interval;
+    if (now - this->last_loop_ < loop_interval)
+      delay_time = loop_interval - (now - this->last_loop_);
 
     uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
     // next_schedule is max 0.5*delay_time
     // otherwise interval=0 schedules result in constant looping with almost no sleep
-    next_schedule = std::max(next_schedule, delay_time / 2);
+    next_schedule = std::max(next_schedule, std::min(delay_time, this->loop_interval_) / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+#ifdef USE_COMPONENT_PROFILING
+    this->next_loop_us_ = micros() + delay_time * 1000;
+#endif
+    if (this->event_driven_loop_) {
+      this->wait_for_wakeup_(delay_time);
+    } else {
+      delay(delay_time);
+    }
   }
   this->last_loop_ = now;
 
@@ -145,6 +192,88 @@ void Application::calculate_looping_components_() {
   }
 }
 
+void Application::wait_for_wakeup_(uint32_t delay_time) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (!this->socket_fds_.empty() && this->setup_wake_socket_()) {
+    this->select_waiting_.store(true);
+    // wake_loop() always notifies before checking select_waiting_, so a wakeup that raced with setting the flag is
+    // still pending here
+    if (arch_wait_for_wakeup(0)) {
+      this->select_waiting_.store(false);
+      return;
+    }
+
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(this->wake_socket_fd_, &read_fds);
+    int max_fd = this->wake_socket_fd_;
+    for (int fd : this->socket_fds_) {
+      FD_SET(fd, &read_fds);
+      max_fd = std::max(max_fd, fd);
+    }
+    struct timeval tv;
+    tv.tv_sec = delay_time / 1000;
+    tv.tv_usec = (delay_time % 1000) * 1000;
+    int ret = ::select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+    this->select_waiting_.store(false);
+
+    if (ret > 0 && FD_ISSET(this->wake_socket_fd_, &read_fds)) {
+      uint8_t buf[16];
+      while (::recv(this->wake_socket_fd_, buf, sizeof(buf), 0) > 0) {
+      }
+    }
+    // Consume the notification that came with any wakeup during the select(), the loop is about to run anyway
+    arch_wait_for_wakeup(0);
+    return;
+  }
+#endif
+  arch_wait_for_wakeup(delay_time);
+}
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+void Application::register_socket_fd(int fd) {
+  if (fd < 0 || fd >= FD_SETSIZE) {
+    ESP_LOGW(TAG, "Socket fd %d can't be waited on", fd);
+    return;
+  }
+  this->socket_fds_.push_back(fd);
+}
+void Application::unregister_socket_fd(int fd) {
+  auto it = std::find(this->socket_fds_.begin(), this->socket_fds_.end(), fd);
+  if (it != this->socket_fds_.end())
+    this->socket_fds_.erase(it);
+}
+bool Application::setup_wake_socket_() {
+  if (this->wake_socket_fd_ != -1)
+    return this->wake_socket_fd_ >= 0;
+
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t len = sizeof(addr);
+  // Connect the socket to itself so that wake_select_() can just send() to it
+  if (fd < 0 || ::bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      ::getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len) != 0 ||
+      ::connect(fd, reinterpret_cast<struct sockaddr *>(&addr), len) != 0) {
+    ESP_LOGW(TAG, "Failed to create loop wake socket, wakeups will be delayed while sockets are open");
+    if (fd >= 0)
+      ::close(fd);
+    this->wake_socket_fd_ = -2;
+    return false;
+  }
+  ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  this->wake_socket_fd_ = fd;
+  return true;
+}
+void Application::wake_select_() {
+  const uint8_t data = 0;
+  ::send(this->wake_socket_fd_, &data, 1, 0);
+}
+#endif
+
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome
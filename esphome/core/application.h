@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include "esphome/core/defines.h"
@@ -61,47 +62,78 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   void register_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
     this->binary_sensors_.push_back(binary_sensor);
+    this->binary_sensors_by_key_.invalidate();
   }
 #endif
 
 #ifdef USE_SENSOR
-  void register_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void register_sensor(sensor::Sensor *sensor) {
+    this->sensors_.push_back(sensor);
+    this->sensors_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_SWITCH
-  void register_switch(switch_::Switch *a_switch) { this->switches_.push_back(a_switch); }
+  void register_switch(switch_::Switch *a_switch) {
+    this->switches_.push_back(a_switch);
+    this->switches_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_BUTTON
-  void register_button(button::Button *button) { this->buttons_.push_back(button); }
+  void register_button(button::Button *button) {
+    this->buttons_.push_back(button);
+    this->buttons_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  void register_text_sensor(text_sensor::TextSensor *sensor) { this->text_sensors_.push_back(sensor); }
+  void register_text_sensor(text_sensor::TextSensor *sensor) {
+    this->text_sensors_.push_back(sensor);
+    this->text_sensors_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_FAN
-  void register_fan(fan::FanState *state) { this->fans_.push_back(state); }
+  void register_fan(fan::FanState *state) {
+    this->fans_.push_back(state);
+    this->fans_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_COVER
-  void register_cover(cover::Cover *cover) { this->covers_.push_back(cover); }
+  void register_cover(cover::Cover *cover) {
+    this->covers_.push_back(cover);
+    this->covers_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_CLIMATE
-  void register_climate(climate::Climate *climate) { this->climates_.push_back(climate); }
+  void register_climate(climate::Climate *climate) {
+    this->climates_.push_back(climate);
+    this->climates_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_LIGHT
-  void register_light(light::LightState *light) { this->lights_.push_back(light); }
+  void register_light(light::LightState *light) {
+    this->lights_.push_back(light);
+    this->lights_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_NUMBER
-  void register_number(number::Number *number) { this->numbers_.push_back(number); }
+  void register_number(number::Number *number) {
+    this->numbers_.push_back(number);
+    this->numbers_by_key_.invalidate();
+  }
 #endif
 
 #ifdef USE_SELECT
-  void register_select(select::Select *select) { this->selects_.push_back(select); }
+  void register_select(select::Select *select) {
+    this->selects_.push_back(select);
+    this->selects_by_key_.invalidate();
+  }
 #endif
 
   /// Register the component in this Application instance.
@@ -139,6 +171,44 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Enable event-driven loop mode.
+   *
+   * In this mode, loop() is only called for components reporting work in has_pending_loop_work(). When no component
+   * had work to do, the application sleeps until the next scheduled item is due (at most max_sleep milliseconds)
+   * instead of waking up every loop interval. wake_loop() ends the sleep early.
+   */
+  void set_event_driven_loop(bool event_driven_loop) { this->event_driven_loop_ = event_driven_loop; }
+
+  /// Wake up the main loop if it's sleeping in event-driven mode. Safe to call from other tasks, but not from interrupt
+  /// handlers.
+  void wake_loop() {
+    if (!this->event_driven_loop_)
+      return;
+    arch_wake_loop();
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    // The notification above doesn't end a select(), so poke the wake socket if the loop is waiting in one
+    if (this->select_waiting_.exchange(false))
+      this->wake_select_();
+#endif
+  }
+  /// Wake up the main loop if it's sleeping in event-driven mode. Safe to call from interrupt handlers.
+  ///
+  /// Note: while sockets are registered, the loop sleeps in select() and this only takes effect once that returns.
+  void IRAM_ATTR wake_loop_isr() {
+    if (this->event_driven_loop_)
+      arch_wake_loop_isr();
+  }
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /** Register a socket file descriptor that wakes up the event-driven loop when it becomes readable.
+   *
+   * Must be called from the main task. Sockets have to be unregistered before they are closed, and their owner has to
+   * read pending data in its loop(), otherwise the loop keeps waking up.
+   */
+  void register_socket_fd(int fd);
+  void unregister_socket_fd(int fd);
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -158,103 +228,77 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
+#ifdef USE_COMPONENT_PROFILING
+  /// How late (in µs) each loop() iteration started compared to the end of the delay of the previous iteration.
+  ExecutionProfile &get_loop_jitter_profile() { return this->loop_jitter_profile_; }
+#endif
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->binary_sensors_by_key_.find(this->binary_sensors_, key, include_internal);
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->switches_by_key_.find(this->switches_, key, include_internal);
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->buttons_by_key_.find(this->buttons_, key, include_internal);
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->sensors_by_key_.find(this->sensors_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->text_sensors_by_key_.find(this->text_sensors_, key, include_internal);
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::FanState *> &get_fans() { return this->fans_; }
   fan::FanState *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->fans_by_key_.find(this->fans_, key, include_internal);
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->covers_by_key_.find(this->covers_, key, include_internal);
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->lights_by_key_.find(this->lights_, key, include_internal);
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->climates_by_key_.find(this->climates_, key, include_internal);
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->numbers_by_key_.find(this->numbers_, key, include_internal);
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->selects_by_key_.find(this->selects_, key, include_internal);
   }
 #endif
 
@@ -269,41 +313,60 @@ class Application {
 
   void feed_wdt_arch_();
 
+  /// Sleep for at most delay_time milliseconds in event-driven mode, returning early on a wakeup.
+  void wait_for_wakeup_(uint32_t delay_time);
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  bool setup_wake_socket_();
+  void wake_select_();
+#endif
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
+  EntityKeyIndex<binary_sensor::BinarySensor> binary_sensors_by_key_;
 #endif
 #ifdef USE_SWITCH
   std::vector<switch_::Switch *> switches_{};
+  EntityKeyIndex<switch_::Switch> switches_by_key_;
 #endif
 #ifdef USE_BUTTON
   std::vector<button::Button *> buttons_{};
+  EntityKeyIndex<button::Button> buttons_by_key_;
 #endif
 #ifdef USE_SENSOR
   std::vector<sensor::Sensor *> sensors_{};
+  EntityKeyIndex<sensor::Sensor> sensors_by_key_;
 #endif
 #ifdef USE_TEXT_SENSOR
   std::vector<text_sensor::TextSensor *> text_sensors_{};
+  EntityKeyIndex<text_sensor::TextSensor> text_sensors_by_key_;
 #endif
 #ifdef USE_FAN
   std::vector<fan::FanState *> fans_{};
+  EntityKeyIndex<fan::FanState> fans_by_key_;
 #endif
 #ifdef USE_COVER
   std::vector<cover::Cover *> covers_{};
+  EntityKeyIndex<cover::Cover> covers_by_key_;
 #endif
 #ifdef USE_CLIMATE
   std::vector<climate::Climate *> climates_{};
+  EntityKeyIndex<climate::Climate> climates_by_key_;
 #endif
 #ifdef USE_LIGHT
   std::vector<light::LightState *> lights_{};
+  EntityKeyIndex<light::LightState> lights_by_key_;
 #endif
 #ifdef USE_NUMBER
   std::vector<number::Number *> numbers_{};
+  EntityKeyIndex<number::Number> numbers_by_key_;
 #endif
 #ifdef USE_SELECT
   std::vector<select::Select *> selects_{};
+  EntityKeyIndex<select::Select> selects_by_key_;
 #endif
 
   std::string name_;
@@ -311,8 +374,19 @@ class Application {
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+  bool event_driven_loop_{false};
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  std::vector<int> socket_fds_;
+  /// Loopback UDP socket used to end a select() early, -1 if not created yet and -2 if that failed.
+  int wake_socket_fd_{-1};
+  std::atomic<bool> select_waiting_{false};
+#endif
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+#ifdef USE_COMPONENT_PROFILING
+  ExecutionProfile loop_jitter_profile_;
+  uint32_t next_loop_us_{0};
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
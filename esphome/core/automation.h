@@ -71,6 +71,13 @@ template<typename... Ts> class Condition {
   /// Check whether this condition passes. This condition check must be instant, and not cause any delays.
   virtual bool check(Ts... x) = 0;
 
+  /** Register a callback that is called whenever the result of check() may have changed.
+   *
+   * Conditions built from entity states subscribe to the state callbacks of those entities. Returns false if this
+   * condition can't report its changes, in which case it has to be polled instead.
+   */
+  virtual bool add_on_change_callback(std::function<void()> &&callback) { return false; }
+
   /// Call check with a tuple of values as parameter.
   bool check_tuple(const std::tuple<Ts...> &tuple) {
     return this->check_tuple_(tuple, typename gens<sizeof...(Ts)>::type());
@@ -1,10 +1,22 @@
 #pragma once
 
+#include "esphome/core/application.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 
 namespace esphome {
 
+/// Register callback with all conditions, returns whether all of them can report their changes.
+template<typename... Ts>
+bool add_on_change_callback_all(const std::vector<Condition<Ts...> *> &conditions, std::function<void()> &&callback) {
+  bool reactive = true;
+  for (auto *condition : conditions) {
+    if (!condition->add_on_change_callback(std::function<void()>(callback)))
+      reactive = false;
+  }
+  return reactive;
+}
+
 template<typename... Ts> class AndCondition : public Condition<Ts...> {
  public:
   explicit AndCondition(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {}
@@ -16,6 +28,9 @@ template<typename... Ts> class AndCondition : public Condition<Ts...> {
 
     return true;
   }
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    return add_on_change_callback_all(this->conditions_, std::move(callback));
+  }
 
  protected:
   std::vector<Condition<Ts...> *> conditions_;
@@ -32,6 +47,9 @@ template<typename... Ts> class OrCondition : public Condition<Ts...> {
 
     return false;
   }
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    return add_on_change_callback_all(this->conditions_, std::move(callback));
+  }
 
  protected:
   std::vector<Condition<Ts...> *> conditions_;
@@ -41,6 +59,9 @@ template<typename... Ts> class NotCondition : public Condition<Ts...> {
  public:
   explicit NotCondition(Condition<Ts...> *condition) : condition_(condition) {}
   bool check(Ts... x) override { return !this->condition_->check(x...); }
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    return this->condition_->add_on_change_callback(std::move(callback));
+  }
 
  protected:
   Condition<Ts...> *condition_;
@@ -61,24 +82,68 @@ template<typename... Ts> class ForCondition : public Condition<Ts...>, public Co
 
   TEMPLATABLE_VALUE(uint32_t, time);
 
-  void loop() override { this->check_internal(); }
+  void setup() override {
+    this->subscribe_();
+    // Conditions set up earlier may have published their state before we subscribed, those count as true since boot
+    this->active_ = this->condition_->check();
+    if (!this->active_)
+      this->last_inactive_ = millis();
+  }
+  void loop() override {
+    // Only polled when the condition can't report its changes
+    if (!this->reactive_)
+      this->check_internal();
+  }
+  bool has_pending_loop_work() override { return !this->reactive_; }
   float get_setup_priority() const override { return setup_priority::DATA; }
   bool check_internal() {
     bool cond = this->condition_->check();
-    if (!cond)
+    if (!cond || (this->reactive_ && !this->active_))
       this->last_inactive_ = millis();
+    this->active_ = cond;
     return cond;
   }
 
   bool check(Ts... x) override {
     if (!this->check_internal())
       return false;
-    return millis() - this->last_inactive_ >= this->time_.value(x...);
+    const uint32_t time = this->time_.value(x...);
+    const uint32_t elapsed = millis() - this->last_inactive_;
+    if (elapsed >= time)
+      return true;
+    if (this->reactive_) {
+      // Report the change once the time has passed, nothing else would
+      this->set_timeout("time", time - elapsed, [this]() { this->change_callback_.call(); });
+    }
+    return false;
+  }
+
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    if (!this->subscribe_())
+      return false;
+    this->change_callback_.add(std::move(callback));
+    return true;
   }
 
  protected:
+  bool subscribe_() {
+    if (!this->subscribed_) {
+      this->subscribed_ = true;
+      this->reactive_ = this->condition_->add_on_change_callback([this]() {
+        this->check_internal();
+        this->change_callback_.call();
+      });
+    }
+    return this->reactive_;
+  }
+
   Condition<> *condition_;
   uint32_t last_inactive_{0};
+  bool active_{false};
+  bool subscribed_{false};
+  /// Whether the condition reports its changes, so that it doesn't have to be polled.
+  bool reactive_{false};
+  CallbackManager<void()> change_callback_;
 };
 
 class StartupTrigger : public Trigger<>, public Component {
@@ -109,16 +174,69 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    // Keep the arguments in a reused slot, so that the callback only captures a ticket and fits into the
+    // std::function without a heap allocation.
+    const size_t index = this->acquire_slot_();
+    Slot *slot = this->slots_[index].get();
+    slot->args = std::forward_as_tuple(x...);
+    const uint32_t ticket = (static_cast<uint32_t>(slot->generation) << 16) | index;
+    this->set_timeout(this->delay_.value(x...), [this, ticket]() { this->play_slot_(ticket); });
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    this->cancel_timeout("");
+    // A delay that is playing right now must neither release nor play its slot after it has been reused
+    for (auto &slot : this->slots_) {
+      slot->generation++;
+      slot->in_use = false;
+    }
+  }
+
+ protected:
+  struct Slot {
+    /// Copies of the arguments, reference arguments like the BLE advertisements only live during the trigger.
+    std::tuple<typename std::decay<Ts>::type...> args;
+    /// Bumped whenever the slot is acquired or stopped, so that callbacks of earlier delays can tell it was reused.
+    uint16_t generation;
+    bool in_use;
+  };
+
+  /// Find a free slot, adding one if all are in use. Slots are never released, so after the most concurrent delays
+  /// this action sees no more allocations are needed (apart from copying arguments that don't fit their buffers).
+  size_t acquire_slot_() {
+    for (size_t i = 0; i < this->slots_.size(); i++) {
+      Slot *slot = this->slots_[i].get();
+      if (!slot->in_use) {
+        slot->generation++;
+        slot->in_use = true;
+        return i;
+      }
+    }
+    this->slots_.emplace_back(new Slot{{}, 0, true});  // NOLINT
+    return this->slots_.size() - 1;
+  }
+  /// Play the slot from a ticket holding the slot index in the low and its generation in the high 16 bits.
+  void play_slot_(uint32_t ticket) {
+    // Following actions may get references into the slot, so it's only released once they return. Slots are kept
+    // behind pointers so that delays started in the meantime don't move it.
+    Slot *slot = this->slots_[ticket & 0xFFFF].get();
+    const uint16_t generation = ticket >> 16;
+    if (!slot->in_use || slot->generation != generation)
+      return;
+    this->play_slot_args_(slot->args, typename gens<sizeof...(Ts)>::type());
+    if (slot->generation == generation)
+      slot->in_use = false;
+  }
+  template<int... S> void play_slot_args_(const std::tuple<typename std::decay<Ts>::type...> &args, seq<S...>) {
+    this->play_next_(std::get<S>(args)...);
+  }
+
+  std::vector<std::unique_ptr<Slot>> slots_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -199,7 +317,7 @@ template<typename... Ts> class WhileAction : public Action<Ts...> {
   void play_complex(Ts... x) override {
     this->num_running_++;
     // Store loop parameters
-    this->var_ = std::make_tuple(x...);
+    this->var_ = std::forward_as_tuple(x...);
     // Initial condition check
     if (!this->condition_->check_tuple(this->var_)) {
       // If new condition check failed, stop loop if running
@@ -241,7 +359,7 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
 
   void play_complex(Ts... x) override {
     this->num_running_++;
-    this->var_ = std::make_tuple(x...);
+    this->var_ = std::forward_as_tuple(x...);
     this->iteration_ = 0;
     this->then_.play_tuple(this->var_);
   }
@@ -263,6 +381,17 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
 
   TEMPLATABLE_VALUE(uint32_t, timeout_value)
 
+  void setup() override {
+    this->reactive_ = this->condition_->add_on_change_callback([this]() {
+      if (this->num_running_ == 0)
+        return;
+      this->changed_ = true;
+      App.wake_loop();
+    });
+    // An action started before setup() might have missed a change, so check the condition once more
+    this->changed_ = true;
+  }
+
   void play_complex(Ts... x) override {
     this->num_running_++;
     // Check if we can continue immediately.
@@ -272,11 +401,12 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       }
       return;
     }
-    this->var_ = std::make_tuple(x...);
+    // Assign element-wise so the stored arguments reuse their buffers
+    this->var_ = std::forward_as_tuple(x...);
 
     if (this->timeout_value_.has_value()) {
-      auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
+      this->set_timeout("timeout", this->timeout_value_.value(x...),
+                        [this]() { this->play_next_tuple_(this->var_); });
     }
 
     this->loop();
@@ -285,6 +415,12 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
   void loop() override {
     if (this->num_running_ == 0)
       return;
+    if (this->reactive_) {
+      // Only check again when the condition reported a change
+      if (!this->changed_)
+        return;
+      this->changed_ = false;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
@@ -294,6 +430,7 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
 
     this->play_next_tuple_(this->var_);
   }
+  bool has_pending_loop_work() override { return this->num_running_ > 0 && (!this->reactive_ || this->changed_); }
 
   float get_setup_priority() const override { return setup_priority::DATA; }
 
@@ -305,6 +442,9 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
  protected:
   Condition<Ts...> *condition_;
   std::tuple<Ts...> var_{};
+  /// Whether the condition reports its changes, so that it doesn't have to be polled.
+  bool reactive_{false};
+  bool changed_{false};
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
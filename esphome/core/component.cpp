@@ -4,6 +4,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 #include <utility>
 
 namespace esphome {
@@ -135,6 +136,7 @@ void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std:
 }
 bool Component::is_failed() { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::can_proceed() { return true; }
+bool Component::has_pending_loop_work() { return true; }
 bool Component::status_has_warning() { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() { return this->component_state_ & STATUS_LED_ERROR; }
 void Component::status_set_warning() {
@@ -190,9 +192,24 @@ void PollingComponent::call_setup() {
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
-WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
+#ifdef USE_COMPONENT_PROFILING
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, bool scheduled)
+    : started_(millis()), component_(component), started_us_(micros()), scheduled_(scheduled) {}
+#else
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, bool scheduled)
     : started_(millis()), component_(component) {}
+#endif
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_COMPONENT_PROFILING
+  if (this->component_ != nullptr) {
+    uint32_t duration_us = micros() - this->started_us_;
+    if (this->scheduled_) {
+      this->component_->get_scheduler_profile().record(duration_us);
+    } else {
+      this->component_->get_loop_profile().record(duration_us);
+    }
+  }
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
@@ -202,4 +219,30 @@ WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
   }
 }
 
+#ifdef USE_COMPONENT_PROFILING
+void ExecutionProfile::record(uint32_t duration_us) {
+  this->count_++;
+  this->total_us_ += duration_us;
+  if (duration_us > this->max_us_)
+    this->max_us_ = duration_us;
+  uint8_t bucket = 0;
+  while (bucket < HISTOGRAM_BUCKETS - 1 && (duration_us >> (bucket + 1)) != 0)
+    bucket++;
+  this->histogram_[bucket]++;
+}
+void ExecutionProfile::reset() { *this = ExecutionProfile(); }
+uint32_t ExecutionProfile::get_percentile_us(float percentile) const {
+  if (this->count_ == 0)
+    return 0;
+  auto target = static_cast<uint32_t>(std::ceil(this->count_ * percentile / 100.0f));
+  uint32_t seen = 0;
+  for (uint8_t bucket = 0; bucket < HISTOGRAM_BUCKETS - 1; bucket++) {
+    seen += this->histogram_[bucket];
+    if (seen >= target)
+      return std::min((uint32_t(2) << bucket) - 1, this->max_us_);
+  }
+  return this->max_us_;
+}
+#endif
+
 }  // namespace esphome
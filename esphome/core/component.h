@@ -4,6 +4,7 @@
 #include <functional>
 #include <cmath>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -63,6 +64,34 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum RetryResult { DONE, RETRY };
 
+#ifdef USE_COMPONENT_PROFILING
+/** Accumulated execution time statistics, used to find out which component is using up loop time.
+ *
+ * Durations are counted in a fixed log2 histogram (bucket i holds durations below 2^(i+1) µs), so recording a sample
+ * is cheap and the memory use doesn't grow with the number of samples.
+ */
+class ExecutionProfile {
+ public:
+  static const uint8_t HISTOGRAM_BUCKETS = 16;
+
+  void record(uint32_t duration_us);
+  void reset();
+
+  uint32_t get_count() const { return this->count_; }
+  uint64_t get_total_us() const { return this->total_us_; }
+  uint32_t get_max_us() const { return this->max_us_; }
+  /// Estimate the given percentile (0-100) of the recorded durations, as the upper bound of its histogram bucket.
+  uint32_t get_percentile_us(float percentile) const;
+  const uint32_t *get_histogram() const { return this->histogram_; }
+
+ protected:
+  uint32_t count_{0};
+  uint64_t total_us_{0};
+  uint32_t max_us_{0};
+  uint32_t histogram_[HISTOGRAM_BUCKETS]{};
+};
+#endif
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -120,6 +149,14 @@ class Component {
 
   virtual bool can_proceed();
 
+  /** Whether loop() has work to do, only consulted when the application runs in event-driven mode.
+   *
+   * Components that know when they have work to do (a queue is non-empty, an interrupt fired) can override this and
+   * call App.wake_loop() or App.wake_loop_isr() when that work arrives, so that the application can sleep until then.
+   * Defaults to true, so loop() keeps being called every loop interval.
+   */
+  virtual bool has_pending_loop_work();
+
   bool status_has_warning();
 
   bool status_has_error();
@@ -149,6 +186,13 @@ class Component {
    */
   const char *get_component_source() const;
 
+#ifdef USE_COMPONENT_PROFILING
+  /// Execution time statistics of this component's loop() (and setup()) calls.
+  ExecutionProfile &get_loop_profile() { return this->loop_profile_; }
+  /// Execution time statistics of the timeouts/intervals/retries scheduled by this component.
+  ExecutionProfile &get_scheduler_profile() { return this->scheduler_profile_; }
+#endif
+
  protected:
   friend class Application;
 
@@ -255,6 +299,10 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_ = nullptr;
+#ifdef USE_COMPONENT_PROFILING
+  ExecutionProfile loop_profile_;
+  ExecutionProfile scheduler_profile_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -298,12 +346,21 @@ class PollingComponent : public Component {
 
 class WarnIfComponentBlockingGuard {
  public:
-  WarnIfComponentBlockingGuard(Component *component);
+  /** Warn if the guarded operation of component takes too long.
+   *
+   * @param component The component that is being run, may be nullptr.
+   * @param scheduled Whether this is a scheduled callback rather than a loop() call, used for profiling.
+   */
+  WarnIfComponentBlockingGuard(Component *component, bool scheduled = false);
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_COMPONENT_PROFILING
+  uint32_t started_us_;
+  bool scheduled_;
+#endif
 };
 
 }  // namespace esphome
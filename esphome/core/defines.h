@@ -18,6 +18,7 @@
 #define USE_BINARY_SENSOR
 #define USE_BUTTON
 #define USE_CLIMATE
+#define USE_COMPONENT_PROFILING
 #define USE_COVER
 #define USE_DEEP_SLEEP
 #define USE_FAN
@@ -25,6 +26,7 @@
 #define USE_HOMEASSISTANT_TIME
 #define USE_LIGHT
 #define USE_LOGGER
+#define USE_LOGGER_DEFERRED
 #define USE_MDNS
 #define USE_NUMBER
 #define USE_OTA_PASSWORD
@@ -49,6 +51,7 @@
 #define USE_WEBSERVER
 #define USE_WIFI_WPA2_EAP
 #define WEBSERVER_PORT 80  // NOLINT
+#define JSON_PARSE_CAPACITY 512  // NOLINT
 #endif
 
 // ESP32-specific feature flags
@@ -58,6 +61,7 @@
 #define USE_ESP32_IGNORE_EFUSE_MAC_CRC
 #define USE_IMPROV
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 
 #ifdef USE_ARDUINO
 #define USE_ETHERNET
@@ -5,6 +5,8 @@ namespace esphome {
 
 static const char *const TAG = "entity_base";
 
+uint32_t EntityBase::object_id_generation_ = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 EntityBase::EntityBase(std::string name) : name_(std::move(name)) { this->calc_object_id_(); }
 
 // Entity Name
@@ -38,6 +40,8 @@ void EntityBase::calc_object_id_() {
   this->object_id_ = str_sanitize(str_snake_case(this->name_));
   // FNV-1 hash
   this->object_id_hash_ = fnv1_hash(this->object_id_);
+  // Indexes by key have to be rebuilt
+  object_id_generation_++;
 }
 uint32_t EntityBase::get_object_id_hash() { return this->object_id_hash_; }
 
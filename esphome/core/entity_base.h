@@ -1,7 +1,10 @@
 #pragma once
 
-#include <string>
+#include <algorithm>
 #include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace esphome {
 
@@ -45,10 +48,15 @@ class EntityBase {
   const std::string &get_icon() const;
   void set_icon(const std::string &name);
 
+  // Get a counter that changes whenever the object ID of any entity changes
+  static uint32_t get_object_id_generation() { return object_id_generation_; }
+
  protected:
   virtual uint32_t hash_base() = 0;
   void calc_object_id_();
 
+  static uint32_t object_id_generation_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
   std::string name_;
   std::string object_id_;
   std::string icon_;
@@ -58,4 +66,49 @@ class EntityBase {
   EntityCategory entity_category_{ENTITY_CATEGORY_NONE};
 };
 
+/** Index of entities sorted by object id hash, to find an entity by its key with a binary search.
+ *
+ * Entities get their name (and thus their key) only after they've been registered, so the index is rebuilt on the
+ * first lookup after it has been invalidated, or after any entity was renamed.
+ */
+template<typename T> class EntityKeyIndex {
+ public:
+  /// Mark the index as outdated, call when an entity was added.
+  void invalidate() { this->valid_ = false; }
+
+  /// Find the entity in entities with the given key.
+  T *find(const std::vector<T *> &entities, uint32_t key, bool include_internal) {
+    if (!this->valid_ || this->generation_ != EntityBase::get_object_id_generation())
+      this->rebuild_(entities);
+
+    auto it = std::lower_bound(this->index_.begin(), this->index_.end(), key,
+                               [](const std::pair<uint32_t, T *> &entry, uint32_t key) { return entry.first < key; });
+    // keys aren't guaranteed to be unique, check all candidates
+    for (; it != this->index_.end() && it->first == key; ++it) {
+      if (include_internal || !it->second->is_internal())
+        return it->second;
+    }
+    return nullptr;
+  }
+
+ protected:
+  void rebuild_(const std::vector<T *> &entities) {
+    this->index_.clear();
+    this->index_.reserve(entities.size());
+    for (auto *obj : entities)
+      this->index_.emplace_back(obj->get_object_id_hash(), obj);
+    // stable, so that duplicate keys are found in registration order like before
+    std::stable_sort(this->index_.begin(), this->index_.end(),
+                     [](const std::pair<uint32_t, T *> &a, const std::pair<uint32_t, T *> &b) {
+                       return a.first < b.first;
+                     });
+    this->valid_ = true;
+    this->generation_ = EntityBase::get_object_id_generation();
+  }
+
+  std::vector<std::pair<uint32_t, T *>> index_;
+  uint32_t generation_{0};
+  bool valid_{false};
+};
+
 }  // namespace esphome
@@ -41,6 +41,13 @@ void delayMicroseconds(uint32_t us);  // NOLINT(readability-identifier-naming)
 void __attribute__((noreturn)) arch_restart();
 void arch_init();
 void arch_feed_wdt();
+/// Sleep for at most ms milliseconds, returning early when arch_wake_loop() or arch_wake_loop_isr() is called.
+/// Returns whether a wakeup was consumed; platforms that can't tell always return false.
+bool arch_wait_for_wakeup(uint32_t ms);
+/// Wake up the main loop if it is sleeping in arch_wait_for_wakeup(), safe to call from other tasks.
+void arch_wake_loop();
+/// Wake up the main loop if it is sleeping in arch_wait_for_wakeup(), safe to call from interrupt handlers.
+void arch_wake_loop_isr();
 uint32_t arch_get_cpu_cycle_count();
 uint32_t arch_get_cpu_freq_hz();
 uint8_t progmem_read_byte(const uint8_t *addr);
@@ -46,6 +46,17 @@ void HOT esp_log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+bool esp_log_runtime_overrides_ = false;  // NOLINT
+
+int HOT esp_log_level_for_(const char *tag) {  // NOLINT
+#ifdef USE_LOGGER
+  auto *log = logger::global_logger;
+  if (log != nullptr)
+    return log->level_for(tag);
+#endif
+  return ESPHOME_LOG_LEVEL;
+}
+
 #if defined(USE_ESP32_FRAMEWORK_ARDUINO) || defined(USE_ESP_IDF)
 int HOT esp_idf_log_vprintf_(const char *format, va_list args) {  // NOLINT
 #ifdef USE_LOGGER
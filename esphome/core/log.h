@@ -36,6 +36,12 @@ namespace esphome {
 #define ESPHOME_LOG_LEVEL ESPHOME_LOG_LEVEL_NONE
 #endif
 
+// Most verbose level at which no tag has its level lowered, generated from the per-tag log levels. Messages up to this
+// level skip the per-tag lookup.
+#ifndef ESPHOME_LOG_UNFILTERED_LEVEL
+#define ESPHOME_LOG_UNFILTERED_LEVEL ESPHOME_LOG_LEVEL
+#endif
+
 #define ESPHOME_LOG_COLOR_BLACK "30"
 #define ESPHOME_LOG_COLOR_RED "31"     // ERROR
 #define ESPHOME_LOG_COLOR_GREEN "32"   // INFO
@@ -65,6 +71,16 @@ void esp_log_vprintf_(int level, const char *tag, int line, const __FlashStringH
 #if defined(USE_ESP32_FRAMEWORK_ARDUINO) || defined(USE_ESP_IDF)
 int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
+/// Log level of the given tag.
+int esp_log_level_for_(const char *tag);  // NOLINT
+/// Set when a tag level below ESPHOME_LOG_UNFILTERED_LEVEL is configured at runtime, which disables the fast path.
+extern bool esp_log_runtime_overrides_;  // NOLINT
+
+// Checked at the call site, so that filtered messages don't evaluate their arguments. Only checks a flag for levels
+// that aren't lowered for any tag in the configuration.
+#define ESPHOME_LOG_ENABLED(level, tag) \
+  (((level) <= ESPHOME_LOG_UNFILTERED_LEVEL && !::esphome::esp_log_runtime_overrides_) || \
+   ::esphome::esp_log_level_for_(tag) >= (level))
 
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 #define ESPHOME_LOG_FORMAT(format) F(format)
@@ -74,7 +90,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
 #define esph_log_vv(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_VERY_VERBOSE
 #else
@@ -83,7 +101,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
 #define esph_log_v(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_VERBOSE, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_VERBOSE
 #else
@@ -92,9 +112,13 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_DEBUG
 #define esph_log_d(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_DEBUG, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 #define esph_log_config(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_CONFIG, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_DEBUG
 #define ESPHOME_LOG_HAS_CONFIG
@@ -105,7 +129,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_INFO
 #define esph_log_i(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_INFO, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_INFO
 #else
@@ -114,7 +140,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_WARN
 #define esph_log_w(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_WARN, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_WARN
 #else
@@ -123,7 +151,9 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_ERROR
 #define esph_log_e(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+  (ESPHOME_LOG_ENABLED(ESPHOME_LOG_LEVEL_ERROR, tag) \
+       ? esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
 
 #define ESPHOME_LOG_HAS_ERROR
 #else
@@ -9,6 +9,7 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+static const size_t MAX_POOL_SIZE = 16;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -25,10 +26,7 @@ void HOT Scheduler::set_timeout(Component *component, const std::string &name, u
 
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
+  auto item = this->make_item_(component, name, SchedulerItem::TIMEOUT);
   item->timeout = timeout;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
@@ -56,10 +54,7 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
 
   ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
+  auto item = this->make_item_(component, name, SchedulerItem::INTERVAL);
   item->interval = interval;
   item->last_execution = now - offset - interval;
   item->last_execution_major = this->millis_major_;
@@ -87,10 +82,7 @@ void HOT Scheduler::set_retry(Component *component, const std::string &name, uin
   ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%u,max_attempts=%u, backoff_factor=%0.1f)", name.c_str(),
             initial_wait_time, max_attempts, backoff_increase_factor);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::RETRY;
+  auto item = this->make_item_(component, name, SchedulerItem::RETRY);
   item->interval = initial_wait_time;
   item->retry_countdown = max_attempts;
   item->backoff_multiplier = backoff_increase_factor;
@@ -176,7 +168,9 @@ void IRAM_ATTR HOT Scheduler::call() {
 
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
+        auto failed = std::move(item);
         this->pop_raw_();
+        this->recycle_item_(std::move(failed));
         continue;
       }
 
@@ -189,7 +183,7 @@ void IRAM_ATTR HOT Scheduler::call() {
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
       {
-        WarnIfComponentBlockingGuard guard{item->component};
+        WarnIfComponentBlockingGuard guard{item->component, true};
         if (item->type == SchedulerItem::RETRY)
           retry_result = item->retry_callback();
         else
@@ -208,6 +202,7 @@ void IRAM_ATTR HOT Scheduler::call() {
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        this->recycle_item_(std::move(item));
         continue;
       }
 
@@ -223,6 +218,8 @@ void IRAM_ATTR HOT Scheduler::call() {
             item->interval *= item->backoff_multiplier;
         }
         this->push_(std::move(item));
+      } else {
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -232,6 +229,7 @@ void IRAM_ATTR HOT Scheduler::call() {
 void HOT Scheduler::process_to_add() {
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->recycle_item_(std::move(it));
       continue;
     }
 
@@ -247,7 +245,9 @@ void HOT Scheduler::cleanup_() {
       return;
 
     to_remove_--;
+    auto removed = std::move(item);
     this->pop_raw_();
+    this->recycle_item_(std::move(removed));
   }
 }
 void HOT Scheduler::pop_raw_() {
@@ -255,16 +255,44 @@ void HOT Scheduler::pop_raw_() {
   this->items_.pop_back();
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::make_item_(Component *component, const std::string &name,
+                                                                   Scheduler::SchedulerItem::Type type) {
+  std::unique_ptr<SchedulerItem> item;
+  if (this->pool_.empty()) {
+    item = make_unique<SchedulerItem>();
+  } else {
+    item = std::move(this->pool_.back());
+    this->pool_.pop_back();
+  }
+  item->component = component;
+  // assigning into the recycled string reuses its buffer if it's large enough
+  item->name = name;
+  item->name_hash = name.empty() ? 0 : fnv1_hash(name);
+  item->type = type;
+  item->retry_countdown = 3;
+  item->backoff_multiplier = 1.0f;
+  return item;
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<Scheduler::SchedulerItem> item) {
+  if (this->pool_.size() >= MAX_POOL_SIZE)
+    return;
+  // release anything captured by the callbacks now instead of when the item is reused
+  item->void_callback = nullptr;
+  item->retry_callback = nullptr;
+  this->pool_.push_back(std::move(item));
+}
 bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
   bool ret = false;
+  const uint32_t name_hash = name.empty() ? 0 : fnv1_hash(name);
   for (auto &it : this->items_)
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type && !it->remove &&
+        it->name == name) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   for (auto &it : this->to_add_)
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type && it->name == name) {
       it->remove = true;
       ret = true;
     }
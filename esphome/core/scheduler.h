@@ -29,6 +29,8 @@ class Scheduler {
   struct SchedulerItem {
     Component *component;
     std::string name;
+    /// FNV-1 hash of name, compared before the string itself when cancelling.
+    uint32_t name_hash;
     enum Type { TIMEOUT, INTERVAL, RETRY } type;
     union {
       uint32_t interval;
@@ -74,6 +76,10 @@ class Scheduler {
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
+  /// Get an item from the recycle pool (or allocate a new one) and set the common fields.
+  std::unique_ptr<SchedulerItem> make_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  /// Return a finished or cancelled item to the recycle pool, releasing its callbacks.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
   bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
   bool empty_() {
     this->cleanup_();
@@ -82,6 +88,8 @@ class Scheduler {
 
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /// Previously used items, reused by make_item_() so re-arming timeouts doesn't hit the heap allocator.
+  std::vector<std::unique_ptr<SchedulerItem>> pool_;
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};